@@ -0,0 +1,269 @@
+// Google Benchmark suite over synthetic DBN files
+//
+// Sizes run from L2-resident (192KB) to multi-GB (3GB). Each input is
+// generated on first use under $DBN_BENCH_DIR (default /tmp) and reused
+// across runs. Use --benchmark_filter to skip the large sizes and
+// --benchmark_out=results.json --benchmark_out_format=json for
+// machine-readable results.
+
+#include <benchmark/benchmark.h>
+#include <databento/columnar.hpp>
+#include <databento/parser.hpp>
+#include <databento/synthetic.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fcntl.h>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// ============================================================================
+// Synthetic Input
+// ============================================================================
+
+std::string bench_dir() {
+  const char* dir = std::getenv("DBN_BENCH_DIR");
+  return dir != nullptr ? dir : "/tmp";
+}
+
+// Path of a synthetic file with count records, generated once
+const std::string& synthetic_file(size_t count) {
+  static std::map<size_t, std::string> files;
+  auto it = files.find(count);
+  if (it != files.end()) {
+    return it->second;
+  }
+  const std::string path = bench_dir() + "/dbn_bench_" + std::to_string(count) + ".dbn";
+  struct stat sb;
+  const auto expected = static_cast<off_t>(200 + count * sizeof(databento::MboMsg));
+  if (stat(path.c_str(), &sb) != 0 || sb.st_size != expected) {
+    databento::SyntheticConfig config;
+    config.num_records = count;
+    databento::write_synthetic_dbn(path, config);
+  }
+  return files.emplace(count, path).first->second;
+}
+
+// Drop the file's clean pages from the page cache (no root needed)
+void evict_page_cache(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+  }
+}
+
+void set_throughput(benchmark::State& state, size_t records) {
+  const auto total = static_cast<int64_t>(state.iterations() * records);
+  state.SetItemsProcessed(total);
+  state.SetBytesProcessed(total * static_cast<int64_t>(sizeof(databento::MboMsg)));
+}
+
+// 192KB (L2), 12MB (L3), 192MB, 3GB
+void sizes(benchmark::internal::Benchmark* b) {
+  for (int64_t records : {int64_t{1} << 12, int64_t{1} << 18, int64_t{1} << 22, int64_t{1} << 26}) {
+    b->Arg(records);
+  }
+  b->ArgName("records")->Unit(benchmark::kMillisecond);
+}
+
+// ============================================================================
+// Parse Paths (data already resident)
+// ============================================================================
+
+void BM_ParseMboStdFunction(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  databento::DbnParser parser(synthetic_file(count));
+  parser.load_into_memory();
+  for (auto _ : state) {
+    uint64_t volume = 0;
+    databento::MboCallback callback = [&](const databento::MboMsg& msg) { volume += msg.size; };
+    parser.parse_mbo(callback);
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+void BM_ParseMboTemplate(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  databento::DbnParser parser(synthetic_file(count));
+  parser.load_into_memory();
+  for (auto _ : state) {
+    uint64_t volume = 0;
+    parser.parse_mbo([&](const databento::MboMsg& msg) { volume += msg.size; });
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+void BM_BatchProcessor(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  databento::DbnParser parser(synthetic_file(count));
+  parser.load_into_memory();
+  databento::BatchProcessor processor;
+  for (auto _ : state) {
+    uint64_t volume = 0;
+    processor.process_batches<databento::MboMsg>(
+        parser, [&](const std::vector<databento::MboMsg>& batch) {
+          for (const auto& msg : batch) {
+            volume += msg.size;
+          }
+        });
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+void BM_DirectPointerScan(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  databento::DbnParser parser(synthetic_file(count));
+  parser.load_into_memory();
+  for (auto _ : state) {
+    uint64_t volume = 0;
+    const uint8_t* ptr = parser.get_batch(0, count) + offsetof(databento::MboMsg, size);
+    for (size_t i = 0; i < count; ++i) {
+      volume += databento::read_u32_le(ptr);
+      ptr += parser.record_size();
+    }
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+void BM_DecodeColumns(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  databento::DbnParser parser(synthetic_file(count));
+  parser.load_into_memory();
+  databento::MboColumns columns;
+  constexpr size_t BATCH = 65536;
+  for (auto _ : state) {
+    for (size_t start = 0; start < count; start += BATCH) {
+      const size_t n = std::min(BATCH, count - start);
+      databento::decode_mbo_columns(parser.get_batch(start, n), n, parser.record_size(),
+                                    databento::COL_TS_EVENT | databento::COL_PRICE |
+                                        databento::COL_SIZE,
+                                    columns);
+      benchmark::DoNotOptimize(columns.size.data());
+    }
+  }
+  state.SetLabel(databento::columnar_simd_level());
+  set_throughput(state, count);
+}
+
+// ============================================================================
+// Load + Scan (warm and cold page cache)
+// ============================================================================
+// Registered with UseRealTime(): CPU time leaves out time blocked on I/O,
+// which is most of a cold load.
+
+template<bool Mmap, bool Cold>
+void BM_LoadAndScan(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::string& path = synthetic_file(count);
+  for (auto _ : state) {
+    if constexpr (Cold) {
+      state.PauseTiming();
+      evict_page_cache(path);
+      state.ResumeTiming();
+    }
+    databento::DbnParser parser(path);
+    if constexpr (Mmap) {
+      parser.load_with_mmap();
+    } else {
+      parser.load_into_memory();
+    }
+    uint64_t volume = 0;
+    parser.parse_mbo([&](const databento::MboMsg& msg) { volume += msg.size; });
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+// load_parallel() on all cores, parsing each chunk as it lands (wall time:
+// the reads happen on worker threads)
+template<bool Cold>
+void BM_LoadParallelAndScan(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::string& path = synthetic_file(count);
+  for (auto _ : state) {
+    if constexpr (Cold) {
+      state.PauseTiming();
+      evict_page_cache(path);
+      state.ResumeTiming();
+    }
+    databento::DbnParser parser(path);
+    uint64_t volume = 0;
+    parser.load_parallel(0, databento::DbnParser::DEFAULT_PARALLEL_CHUNK_BYTES,
+                         [&](databento::RecordRange range) {
+      for (size_t i = range.begin; i < range.end; ++i) {
+        volume += databento::parse_mbo(parser.get_record(i)).size;
+      }
+    });
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+// Zero-copy mmap scan with the default sliding window from a cold cache
+void BM_MmapWindowScan(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::string& path = synthetic_file(count);
+  for (auto _ : state) {
+    state.PauseTiming();
+    evict_page_cache(path);
+    state.ResumeTiming();
+    databento::DbnParser parser(path);
+    parser.set_mmap_window(databento::DbnParser::DEFAULT_MMAP_WINDOW_BYTES);
+    parser.load_with_mmap();
+    uint64_t volume = 0;
+    parser.parse_mbo([&](const databento::MboMsg& msg) { volume += msg.size; });
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+// Bounded-memory stream; Direct never touches the page cache, so it has no
+// warm variant
+template<databento::IoBackend Backend, bool Cold>
+void BM_StreamScan(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::string& path = synthetic_file(count);
+  for (auto _ : state) {
+    if constexpr (Cold) {
+      state.PauseTiming();
+      evict_page_cache(path);
+      state.ResumeTiming();
+    }
+    databento::DbnStream stream(path, databento::DbnStream::DEFAULT_MEMORY_BUDGET, Backend);
+    uint64_t volume = 0;
+    stream.parse_mbo([&](const databento::MboMsg& msg) { volume += msg.size; });
+    benchmark::DoNotOptimize(volume);
+  }
+  set_throughput(state, count);
+}
+
+BENCHMARK(BM_ParseMboStdFunction)->Apply(sizes);
+BENCHMARK(BM_ParseMboTemplate)->Apply(sizes);
+BENCHMARK(BM_BatchProcessor)->Apply(sizes);
+BENCHMARK(BM_DirectPointerScan)->Apply(sizes);
+BENCHMARK(BM_DecodeColumns)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_LoadAndScan, false, false)->Name("BM_LoadRead/warm")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LoadAndScan, true, false)->Name("BM_LoadMmap/warm")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LoadAndScan, false, true)->Name("BM_LoadRead/cold")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LoadAndScan, true, true)->Name("BM_LoadMmap/cold")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LoadParallelAndScan, false)->Name("BM_LoadParallel/warm")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LoadParallelAndScan, true)->Name("BM_LoadParallel/cold")->Apply(sizes)->UseRealTime();
+BENCHMARK(BM_MmapWindowScan)->Name("BM_LoadMmapWindow/cold")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StreamScan, databento::IoBackend::Pread, false)->Name("BM_StreamPread/warm")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StreamScan, databento::IoBackend::Pread, true)->Name("BM_StreamPread/cold")->Apply(sizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StreamScan, databento::IoBackend::Direct, false)->Name("BM_StreamDirect")->Apply(sizes)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
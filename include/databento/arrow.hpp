@@ -0,0 +1,77 @@
+#pragma once
+
+#include "columnar.hpp"
+#include "parser.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+// Arrow C Data Interface
+// ============================================================================
+
+// The ABI-stable structs from the Arrow C data interface specification,
+// declared here so no Arrow library is needed. The guard matches the one
+// in Arrow's own abi.h, so the two headers can be mixed.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace databento {
+
+// ============================================================================
+// MBO Batch Export
+// ============================================================================
+
+// Record batches are exported as a struct array with one non-nullable child
+// per selected column, in record order: ts_event as timestamp[ns, UTC],
+// action/side as fixed_size_binary(1), the rest as their unsigned/signed
+// integer types. The consumer owns the outputs and must call their release
+// callbacks.
+
+// Schema of a batch with the given COL_* selection
+void export_mbo_schema(uint32_t columns, ArrowSchema* out);
+
+// Export decoded columns without copying: the array takes ownership of the
+// buffers, which are freed once the array and every child moved out of it
+// have been released
+void export_mbo_columns(MboColumns&& columns, ArrowArray* out);
+
+// Decode records [start, start + count) of a loaded parser and export them
+void export_mbo_batch(const DbnParser& parser, size_t start, size_t count, uint32_t columns,
+                      ArrowSchema* schema, ArrowArray* array);
+
+} // namespace databento
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "buffer.hpp"
+#include "columnar.hpp"
+#include "dbn.hpp"
+#include "parser.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// Bar Intervals
+// ============================================================================
+
+constexpr uint64_t BAR_1S = 1'000'000'000ULL;
+constexpr uint64_t BAR_1M = 60 * BAR_1S;
+constexpr uint64_t BAR_1H = 60 * BAR_1M;
+constexpr uint64_t BAR_1D = 24 * BAR_1H;
+
+// Matching Ohlcv1S..Ohlcv1D rtype for an interval; nullopt for custom ones
+std::optional<RType> ohlcv_rtype(uint64_t interval_ns);
+
+// ============================================================================
+// Columnar OHLCV Output
+// ============================================================================
+
+// Bars of one interval, one row per (instrument, bucket), laid out like the
+// fields of a DBN OHLCV record. ts_event is the bucket start.
+struct OhlcvBars {
+  uint64_t interval_ns = 0;
+
+  std::vector<uint64_t> ts_event;
+  std::vector<uint32_t> instrument_id;
+  std::vector<int64_t> open;
+  std::vector<int64_t> high;
+  std::vector<int64_t> low;
+  std::vector<int64_t> close;
+  std::vector<uint64_t> volume;
+
+  size_t size() const { return ts_event.size(); }
+  void clear();
+};
+
+// ============================================================================
+// Multi-Resolution Bar Builder
+// ============================================================================
+
+// Which records of a batch are trades
+enum class BarSource {
+  Trades,             // Every record (a trades file)
+  MboTrades,          // MBO records with action Trade
+  MboTradesAndFills,  // MBO Trade and Fill (Fill repeats the aggressor's
+                      // Trade from the resting side, so volume double counts)
+};
+
+// Builds OHLCV bars at several intervals per instrument in one pass over
+// the trades. Bars are emitted into bars(k) as they close (a trade lands in
+// a later bucket); flush() emits the ones still open. Trades are expected in
+// ts_event order per instrument; a late trade is counted in the open bar.
+class BarBuilder {
+public:
+  static constexpr size_t BATCH_RECORDS = 65536;
+
+  explicit BarBuilder(std::vector<uint64_t> intervals_ns = {BAR_1S, BAR_1M, BAR_1H, BAR_1D});
+
+  // One trade at a time
+  void add_trade(uint64_t ts_event, uint32_t instrument_id, int64_t price, uint32_t size);
+  void add(const TradeMsg& msg) { add_trade(msg.ts_event, msg.instrument_id, msg.price, msg.size); }
+
+  // A batch of count records (rec_size bytes apart, MBO/Trade layout).
+  // Fields are transposed with the SIMD column kernels and bucketed per
+  // interval column-wise, dividing only when a bucket boundary is crossed.
+  void consume(const uint8_t* records, size_t count, size_t rec_size,
+               BarSource source = BarSource::Trades);
+
+  // A whole file in batches (memory-mapped if not loaded). An MBO file needs
+  // one of the Mbo* sources; with Trades it throws std::invalid_argument.
+  void consume(DbnParser& parser, BarSource source = BarSource::Trades);
+
+  // Emit every open bar
+  void flush();
+
+  size_t num_intervals() const { return intervals_.size(); }
+  const OhlcvBars& bars(size_t interval_index) const { return output_[interval_index]; }
+
+private:
+  struct Bar {
+    uint64_t bucket;
+    int64_t open;
+    int64_t high;
+    int64_t low;
+    int64_t close;
+    uint64_t volume;
+    bool active;
+  };
+
+  std::vector<uint64_t> intervals_;
+  std::vector<OhlcvBars> output_;
+
+  // Per instrument, num_intervals() consecutive bars
+  std::unordered_map<uint32_t, size_t> slots_;
+  std::vector<uint32_t> slot_ids_;
+  std::vector<Bar> open_bars_;
+  uint32_t last_id_ = 0;
+  size_t last_slot_ = SIZE_MAX;
+
+  // Batch scratch, reused
+  MboColumns columns_;
+  AlignedBuffer<uint64_t> buckets_; // Interval-major: [k * count + i]
+  std::vector<uint64_t> bucket_start_;
+
+  Bar* bars_for(uint32_t instrument_id);
+  void update(Bar* bars, uint32_t instrument_id, const uint64_t* buckets, size_t stride,
+              int64_t price, uint32_t size);
+  void emit(size_t k, uint32_t instrument_id, const Bar& bar);
+};
+
+} // namespace databento
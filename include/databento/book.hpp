@@ -0,0 +1,190 @@
+#pragma once
+
+#include "dbn.hpp"
+#include "parser.hpp"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// Order Id Map
+// ============================================================================
+
+// Open-addressing hash map from order_id to an order pool index. Linear
+// probing with backward-shift deletion, so there are no tombstones and
+// lookups stay short under heavy add/cancel churn.
+class OrderIdMap {
+public:
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  explicit OrderIdMap(size_t expected = 1024);
+
+  // Pool index of order_id, or NONE
+  uint32_t find(uint64_t order_id) const {
+    for (size_t i = hash(order_id) & mask_;; i = (i + 1) & mask_) {
+      const Slot& slot = slots_[i];
+      if (slot.value == NONE || slot.key == order_id) {
+        return slot.value;
+      }
+    }
+  }
+
+  // order_id must not be present
+  void insert(uint64_t order_id, uint32_t value);
+  void erase(uint64_t order_id);
+  void clear();
+
+  size_t size() const { return size_; }
+
+private:
+  struct Slot {
+    uint64_t key;
+    uint32_t value; // NONE = empty
+  };
+
+  std::vector<Slot> slots_;
+  size_t mask_;
+  size_t size_;
+
+  // Final mix of MurmurHash3; order ids are often sequential
+  static size_t hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+  }
+
+  void grow();
+};
+
+// ============================================================================
+// Order Book
+// ============================================================================
+
+// Aggregated price level as seen from outside the book
+struct PriceLevel {
+  int64_t price = UNDEF_PRICE;
+  uint64_t size = 0;
+  uint32_t count = 0; // Orders at this price
+};
+
+struct Bbo {
+  PriceLevel bid;
+  PriceLevel ask;
+};
+
+// Limit order book for one instrument, rebuilt from MBO updates. Orders sit
+// in a pooled node array (FIFO per level through index links); each side is
+// a contiguous level array kept sorted with the best price at the back, so
+// the busy top of book is cheap to insert into, erase from and read.
+class OrderBook {
+public:
+  explicit OrderBook(size_t expected_orders = 1024);
+
+  // Apply one MBO update. Add/Cancel/Modify edit resting orders; Clear
+  // empties the book; Trade and Fill leave it unchanged (the venue's
+  // follow-up Cancel removes the filled size). Updates for unknown orders
+  // are ignored, except Modify, which adds the order.
+  void apply(const MboMsg& msg);
+
+  void clear();
+
+  Bbo bbo() const;
+
+  // Level at depth (0 = best) on a side; an empty PriceLevel past the end
+  PriceLevel bid_level(size_t depth) const;
+  PriceLevel ask_level(size_t depth) const;
+
+  // Fill out with the best out.size() levels of a side; returns how many
+  size_t bids(std::span<PriceLevel> out) const;
+  size_t asks(std::span<PriceLevel> out) const;
+
+  size_t num_bid_levels() const { return bids_.size(); }
+  size_t num_ask_levels() const { return asks_.size(); }
+  size_t num_orders() const { return orders_.size(); }
+
+private:
+  struct Order {
+    uint64_t order_id;
+    int64_t price;
+    uint32_t size;
+    uint32_t prev; // Within the level's queue
+    uint32_t next;
+    bool bid;
+  };
+
+  struct Level {
+    int64_t price;
+    uint64_t size;
+    uint32_t count;
+    uint32_t head; // Oldest order
+    uint32_t tail;
+  };
+
+  OrderIdMap orders_;
+  std::vector<Order> pool_;
+  std::vector<uint32_t> free_;
+  std::vector<Level> bids_; // Ascending: best bid at back
+  std::vector<Level> asks_; // Descending: best ask at back
+
+  std::vector<Level>& side(bool bid) { return bid ? bids_ : asks_; }
+
+  void add(uint64_t order_id, bool bid, int64_t price, uint32_t size);
+  void remove(uint32_t node);
+  void enqueue(Level& level, uint32_t node);
+  void unlink(Level& level, uint32_t node);
+
+  // Position of price in a side: its level, or where to insert one
+  static size_t find_level(const std::vector<Level>& levels, bool bid, int64_t price);
+  static PriceLevel view(const std::vector<Level>& levels, size_t depth);
+};
+
+// ============================================================================
+// Book Builder (Per Instrument)
+// ============================================================================
+
+// Routes MBO updates to one OrderBook per instrument_id
+class BookBuilder {
+public:
+  void apply(const MboMsg& msg) { book(msg.instrument_id).apply(msg); }
+
+  // Book for an instrument, created empty on first use
+  OrderBook& book(uint32_t instrument_id);
+
+  // nullptr if the instrument has had no updates
+  const OrderBook* find(uint32_t instrument_id) const;
+
+  size_t num_books() const { return books_.size(); }
+
+  // Apply every record in the file, calling on_update(msg, book) after
+  // each one (e.g. to sample the BBO)
+  template<typename F>
+    requires std::invocable<F&, const MboMsg&, const OrderBook&>
+  void replay(DbnParser& parser, F&& on_update) {
+    parser.parse_mbo([&](const MboMsg& msg) {
+      OrderBook& target = book(msg.instrument_id);
+      target.apply(msg);
+      on_update(msg, static_cast<const OrderBook&>(target));
+    });
+  }
+
+  void replay(DbnParser& parser) {
+    parser.parse_mbo([this](const MboMsg& msg) { apply(msg); });
+  }
+
+private:
+  std::unordered_map<uint32_t, std::unique_ptr<OrderBook>> books_;
+  // Updates arrive in runs per instrument; skip the hash lookup for those
+  uint32_t last_id_ = 0;
+  OrderBook* last_ = nullptr;
+};
+
+} // namespace databento
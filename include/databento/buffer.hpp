@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace databento {
+
+// ============================================================================
+// Huge Pages
+// ============================================================================
+
+constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20; // 2MB (x86-64, arm64 4K granule)
+
+// Requested backing for large buffers
+enum class HugePages : uint8_t {
+  Off,          // Regular allocation (4KB pages unless THP is "always")
+  Transparent,  // 2MB-aligned anonymous mapping + MADV_HUGEPAGE
+  HugeTlb,      // MAP_HUGETLB from the reserved pool, else Transparent
+};
+
+// What an allocation actually got
+enum class PageBacking : uint8_t {
+  Heap,         // operator new
+  Small,        // Anonymous or file mapping, 4KB pages
+  Transparent,  // MADV_HUGEPAGE accepted; the kernel promotes as it can
+  HugeTlb,      // Reserved 2MB pages, guaranteed
+};
+
+const char* page_backing_name(PageBacking backing);
+
+struct PageAllocation {
+  void* addr = nullptr;
+  size_t bytes = 0;  // Mapped length (rounded up to HUGE_PAGE_SIZE)
+  PageBacking backing = PageBacking::Small;
+};
+
+// Map at least bytes of zeroed anonymous memory, 2MB-aligned, trying the
+// mode's backings in order and falling back to 4KB pages. Throws
+// std::bad_alloc if nothing can be mapped.
+PageAllocation allocate_pages(size_t bytes, HugePages mode);
+void free_pages(const PageAllocation& allocation);
+
+// Bytes of [addr, addr + len) currently backed by huge pages (THP or
+// hugetlb), from /proc/self/smaps. Returns 0 where smaps is unavailable.
+size_t huge_page_bytes(const void* addr, size_t len);
+
+// ============================================================================
+// Aligned Reusable Buffers
+// ============================================================================
+
+// Cache-line aligned, uninitialized storage for trivially copyable
+// elements. Growing discards the old contents: these buffers are meant to be
+// overwritten batch after batch without reallocating. With huge pages
+// enabled, allocations of HUGE_PAGE_SIZE or more come from allocate_pages().
+template<typename T>
+class AlignedBuffer {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  static constexpr size_t ALIGNMENT = 64;
+
+  AlignedBuffer() = default;
+  explicit AlignedBuffer(size_t count) { resize(count); }
+  explicit AlignedBuffer(HugePages huge_pages) : huge_pages_(huge_pages) {}
+  ~AlignedBuffer() { release(); }
+
+  AlignedBuffer(const AlignedBuffer&) = delete;
+  AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+  AlignedBuffer(AlignedBuffer&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        huge_pages_(other.huge_pages_),
+        pages_(std::exchange(other.pages_, PageAllocation{})) {}
+
+  AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+      huge_pages_ = other.huge_pages_;
+      pages_ = std::exchange(other.pages_, PageAllocation{});
+    }
+    return *this;
+  }
+
+  // Set the element count; contents are unspecified if capacity grows
+  void resize(size_t count) {
+    if (count > capacity_) {
+      release();
+      if (huge_pages_ != HugePages::Off && count * sizeof(T) >= HUGE_PAGE_SIZE) {
+        pages_ = allocate_pages(count * sizeof(T), huge_pages_);
+        data_ = static_cast<T*>(pages_.addr);
+      } else {
+        data_ = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ALIGNMENT}));
+      }
+      capacity_ = count;
+    }
+    size_ = count;
+  }
+
+  void clear() { size_ = 0; }
+
+  // Applies from the next allocation on
+  void set_huge_pages(HugePages huge_pages) { huge_pages_ = huge_pages; }
+  HugePages huge_pages() const { return huge_pages_; }
+  PageBacking backing() const { return pages_.addr != nullptr ? pages_.backing : PageBacking::Heap; }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+  T& operator[](size_t i) { return data_[i]; }
+  const T& operator[](size_t i) const { return data_[i]; }
+
+  T* begin() { return data_; }
+  T* end() { return data_ + size_; }
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+
+  std::span<const T> span() const { return {data_, size_}; }
+
+private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  HugePages huge_pages_ = HugePages::Off;
+  PageAllocation pages_; // Set when data_ came from allocate_pages()
+
+  void release() {
+    if (pages_.addr != nullptr) {
+      free_pages(pages_);
+      pages_ = {};
+    } else if (data_ != nullptr) {
+      ::operator delete(data_, std::align_val_t{ALIGNMENT});
+    }
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+  }
+};
+
+} // namespace databento
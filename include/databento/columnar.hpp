@@ -0,0 +1,96 @@
+#pragma once
+
+#include "buffer.hpp"
+#include "dbn.hpp"
+#include <span>
+
+namespace databento {
+
+// ============================================================================
+// Column Selection
+// ============================================================================
+
+constexpr uint32_t COL_TS_EVENT = 1u << 0;
+constexpr uint32_t COL_INSTRUMENT_ID = 1u << 1;
+constexpr uint32_t COL_ACTION = 1u << 2;
+constexpr uint32_t COL_SIDE = 1u << 3;
+constexpr uint32_t COL_FLAGS = 1u << 4;
+constexpr uint32_t COL_DEPTH = 1u << 5;
+constexpr uint32_t COL_PRICE = 1u << 6;
+constexpr uint32_t COL_SIZE = 1u << 7;
+constexpr uint32_t COL_CHANNEL_ID = 1u << 8;
+constexpr uint32_t COL_ORDER_ID = 1u << 9;
+constexpr uint32_t COL_SEQUENCE = 1u << 10;
+constexpr uint32_t COL_TS_IN_DELTA = 1u << 11;
+constexpr uint32_t COL_ALL = (1u << 12) - 1;
+
+// ============================================================================
+// Struct-of-Arrays Batch
+// ============================================================================
+
+// Columnar MBO batch (TradeMsg shares the layout). Only the selected
+// columns are filled; the rest stay empty. Buffers are reused across batches.
+struct MboColumns {
+  size_t count = 0;
+  uint32_t columns = 0;
+
+  AlignedBuffer<uint64_t> ts_event;
+  AlignedBuffer<uint32_t> instrument_id;
+  AlignedBuffer<char> action;
+  AlignedBuffer<char> side;
+  AlignedBuffer<uint8_t> flags;
+  AlignedBuffer<uint8_t> depth;
+  AlignedBuffer<int64_t> price;
+  AlignedBuffer<uint32_t> size;
+  AlignedBuffer<uint32_t> channel_id;
+  AlignedBuffer<uint64_t> order_id;
+  AlignedBuffer<uint32_t> sequence;
+  AlignedBuffer<uint8_t> ts_in_delta;
+
+  // Back columns of HUGE_PAGE_SIZE or more with huge pages (next growth on)
+  void set_huge_pages(HugePages mode);
+};
+
+// Transpose count records (rec_size bytes apart) into the selected columns
+// of out. Uses AVX-512 or AVX2 gathers when compiled for them.
+void decode_mbo_columns(const uint8_t* records, size_t count, size_t rec_size,
+                        uint32_t columns, MboColumns& out);
+
+// ============================================================================
+// MBP Book Ladders
+// ============================================================================
+
+// Bid/ask ladders of an MBP-1 or MBP-10 batch, level-major: the value for
+// record i at level l is at [l * count + i]. Per-level features (e.g. depth
+// imbalance over the top k levels) then vectorize across records.
+struct MbpLadders {
+  size_t count = 0;
+  size_t levels = 0;
+
+  AlignedBuffer<int64_t> bid_px;
+  AlignedBuffer<int64_t> ask_px;
+  AlignedBuffer<uint32_t> bid_sz;
+  AlignedBuffer<uint32_t> ask_sz;
+  AlignedBuffer<uint32_t> bid_ct;
+  AlignedBuffer<uint32_t> ask_ct;
+
+  // Back ladders of HUGE_PAGE_SIZE or more with huge pages (next growth on)
+  void set_huge_pages(HugePages mode);
+
+  // One level's column of a ladder field, e.g. at(bid_sz, 0)
+  template<typename T>
+  std::span<const T> at(const AlignedBuffer<T>& field, size_t level) const {
+    return {field.data() + level * count, count};
+  }
+};
+
+// Extract the best `levels` levels of count MBP records (rec_size bytes
+// apart) into out. Throws std::invalid_argument if the records are too
+// small to hold that many levels.
+void decode_mbp_ladders(const uint8_t* records, size_t count, size_t rec_size,
+                        size_t levels, MbpLadders& out);
+
+// SIMD path compiled into the column kernels: "avx512", "avx2" or "scalar"
+const char* columnar_simd_level();
+
+} // namespace databento
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <string>
@@ -48,8 +49,11 @@ enum class Side : char {
 constexpr uint8_t F_LAST = 0x80;
 constexpr uint8_t F_TOB = 0x01;
 
+// Sentinel for a missing price (e.g. an empty book side)
+constexpr int64_t UNDEF_PRICE = INT64_MAX;
+
 // ============================================================================
-// Record Structures (48 bytes each)
+// Record Structures (MBO/Trade: 48 bytes each)
 // ============================================================================
 
 #pragma pack(push, 1)
@@ -88,8 +92,67 @@ struct TradeMsg {
   uint8_t reserved[3];    // Reserved
 };
 
+// One book level of an MBP record
+struct BidAskPair {
+  int64_t bid_px;         // Bid price
+  int64_t ask_px;         // Ask price
+  uint32_t bid_sz;        // Bid size
+  uint32_t ask_sz;        // Ask size
+  uint32_t bid_ct;        // Bid order count
+  uint32_t ask_ct;        // Ask order count
+};
+
+// MBP-1 Record (Market By Price, top of book): 80 bytes
+struct Mbp1Msg {
+  uint64_t ts_event;      // Event timestamp (ns)
+  uint32_t instrument_id; // Instrument ID
+  char action;            // Action that changed the book
+  char side;              // Side of that action
+  uint8_t flags;          // Flags
+  uint8_t depth;          // Level changed
+  int64_t price;          // Price of the change
+  uint32_t size;          // Size of the change
+  uint32_t sequence;      // Sequence number
+  uint64_t ts_recv;       // Capture timestamp (ns)
+  int32_t ts_in_delta;    // Gateway receive delta
+  uint8_t reserved[4];    // Reserved
+  BidAskPair levels[1];   // Book after the change
+};
+
+// MBP-10 Record (Market By Price, 10 levels): 368 bytes
+struct Mbp10Msg {
+  uint64_t ts_event;      // Event timestamp (ns)
+  uint32_t instrument_id; // Instrument ID
+  char action;            // Action that changed the book
+  char side;              // Side of that action
+  uint8_t flags;          // Flags
+  uint8_t depth;          // Level changed
+  int64_t price;          // Price of the change
+  uint32_t size;          // Size of the change
+  uint32_t sequence;      // Sequence number
+  uint64_t ts_recv;       // Capture timestamp (ns)
+  int32_t ts_in_delta;    // Gateway receive delta
+  uint8_t reserved[4];    // Reserved
+  BidAskPair levels[10];  // Book after the change, best level first
+};
+
 #pragma pack(pop)
 
+static_assert(sizeof(MboMsg) == 48 && sizeof(TradeMsg) == 48);
+static_assert(sizeof(BidAskPair) == 32);
+static_assert(sizeof(Mbp1Msg) == 80 && sizeof(Mbp10Msg) == 368);
+
+// Record size of a schema, or 0 if it has no record struct here
+constexpr size_t record_size_for(RType rtype) {
+  switch (rtype) {
+    case RType::Mbo: return sizeof(MboMsg);
+    case RType::Trade: return sizeof(TradeMsg);
+    case RType::Mbp1: return sizeof(Mbp1Msg);
+    case RType::Mbp10: return sizeof(Mbp10Msg);
+    default: return 0;
+  }
+}
+
 // ============================================================================
 // Inline Binary Readers (Maximum Performance)
 // ============================================================================
@@ -134,6 +197,26 @@ inline TradeMsg parse_trade(const uint8_t* data) {
   return msg;
 }
 
+inline Mbp1Msg parse_mbp1(const uint8_t* data) {
+  Mbp1Msg msg;
+  std::memcpy(&msg, data, sizeof(Mbp1Msg));
+  return msg;
+}
+
+inline Mbp10Msg parse_mbp10(const uint8_t* data) {
+  Mbp10Msg msg;
+  std::memcpy(&msg, data, sizeof(Mbp10Msg));
+  return msg;
+}
+
+// Any of the record structs above
+template<typename RecordType>
+inline RecordType parse_record(const uint8_t* data) {
+  RecordType msg;
+  std::memcpy(&msg, data, sizeof(RecordType));
+  return msg;
+}
+
 // ============================================================================
 // Price Conversion Utilities
 // ============================================================================
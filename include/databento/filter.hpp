@@ -0,0 +1,40 @@
+#pragma once
+
+#include "buffer.hpp"
+#include "dbn.hpp"
+#include "parser.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// Record Filters
+// ============================================================================
+
+// Conjunction of predicates evaluated directly on packed MBO (or Trade)
+// records. Fields left at their defaults match every record.
+struct MboFilter {
+  std::vector<uint32_t> instrument_ids;   // Empty = any instrument
+  char action = 0;                        // 0 = any action
+  char side = 0;                          // 0 = any side
+  int64_t min_price = std::numeric_limits<int64_t>::min();  // Inclusive
+  int64_t max_price = std::numeric_limits<int64_t>::max();  // Inclusive
+  uint64_t min_ts = 0;                                      // Inclusive
+  uint64_t max_ts = std::numeric_limits<uint64_t>::max();   // Inclusive
+};
+
+// Evaluate filter over count records (rec_size bytes apart) and write the
+// indices of matching records, relative to records, into selection.
+// Returns the number selected. Uses AVX-512 or AVX2 when compiled for them;
+// count must fit in 32 bits (select per batch for larger ranges); throws
+// std::invalid_argument otherwise.
+size_t select_mbo(const uint8_t* records, size_t count, size_t rec_size,
+                  const MboFilter& filter, AlignedBuffer<uint32_t>& selection);
+
+// Select over a whole loaded parser; returns absolute record indices.
+// Throws std::invalid_argument unless the parser's schema is Mbo or Trade.
+std::vector<uint64_t> select_mbo(DbnParser& parser, const MboFilter& filter);
+
+} // namespace databento
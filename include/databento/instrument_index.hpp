@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// Per-Instrument Record Index
+// ============================================================================
+
+// Record indices of every instrument_id in a file, as ascending lists
+// delta-encoded into LEB128 varints (typically 1-2 bytes per record).
+// Persisted as a sidecar next to the .dbn so later jobs skip the build pass.
+class InstrumentIndex {
+public:
+  // Sidecar layout version; bumped on any format change
+  static constexpr uint32_t FORMAT_VERSION = 2;
+
+  // Sidecar file used for a given DBN file
+  static std::string sidecar_path(const std::string& dbn_path) { return dbn_path + ".idx"; }
+
+  // One pass over count records (rec_size bytes apart)
+  static InstrumentIndex build(const uint8_t* records, size_t count, size_t rec_size);
+
+  // Write to path; the source size and mtime are stored so stale sidecars
+  // can be detected. Throws std::runtime_error on I/O failure.
+  void save(const std::string& path, uint64_t source_size, int64_t source_mtime_ns) const;
+
+  // Read a sidecar; nullopt if it is missing, malformed or was written for
+  // a different version of the source file. Every entry is decoded and
+  // checked against num_records (the source's record count), so a corrupt
+  // sidecar can never yield an index outside the file.
+  static std::optional<InstrumentIndex> load(const std::string& path,
+                                             uint64_t source_size, int64_t source_mtime_ns,
+                                             uint64_t num_records);
+
+  size_t num_records() const { return num_records_; }
+  size_t num_instruments() const { return entries_.size(); }
+
+  // Instrument ids present, ascending
+  std::vector<uint32_t> instruments() const;
+
+  // Records belonging to instrument_id (0 if absent)
+  size_t count(uint32_t instrument_id) const;
+
+  // Call fn(record_index) for each record of instrument_id, ascending
+  template<typename F>
+  void for_each(uint32_t instrument_id, F&& fn) const {
+    auto it = entries_.find(instrument_id);
+    if (it == entries_.end()) {
+      return;
+    }
+    const uint8_t* ptr = payload_.data() + it->second.offset;
+    uint64_t index = 0;
+    for (uint64_t n = 0; n < it->second.count; ++n) {
+      uint64_t delta = 0;
+      unsigned shift = 0;
+      uint8_t byte;
+      do {
+        byte = *ptr++;
+        delta |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        shift += 7;
+      } while (byte & 0x80);
+      index += delta;
+      fn(static_cast<size_t>(index));
+    }
+  }
+
+  // Decoded record indices of instrument_id
+  std::vector<uint64_t> records(uint32_t instrument_id) const;
+
+private:
+  struct Entry {
+    uint64_t count;
+    uint64_t offset; // Into payload_
+    uint64_t bytes;
+  };
+
+  size_t num_records_ = 0;
+  std::unordered_map<uint32_t, Entry> entries_;
+  std::vector<uint8_t> payload_;
+};
+
+} // namespace databento
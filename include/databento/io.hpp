@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace databento {
+
+// ============================================================================
+// I/O Backends
+// ============================================================================
+
+enum class IoBackend : uint8_t {
+  None,      // Nothing loaded yet
+  Ifstream,  // load_into_memory()
+  Mmap,      // load_with_mmap()
+  Pread,     // Positional reads (also the io_uring fallback)
+  IoUring,   // io_uring submission/completion rings
+  Zstd,      // Decompressed from a .dbn.zst file
+  Direct,    // O_DIRECT reads that bypass the page cache (DbnStream)
+};
+
+const char* io_backend_name(IoBackend backend);
+
+// ============================================================================
+// Positional Reads
+// ============================================================================
+
+// Read up to len bytes at offset, retrying short reads and EINTR. Returns
+// bytes read (less than len only at end of file). Throws on I/O error.
+size_t pread_fully(int fd, uint8_t* dst, size_t len, off_t offset);
+
+// Write all len bytes at offset, retrying short writes and EINTR. Throws on
+// I/O error.
+void pwrite_fully(int fd, const uint8_t* src, size_t len, off_t offset);
+
+// O_DIRECT needs the buffer address, length and file offset aligned to the
+// device's logical block size; 4096 covers every common device
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+// pread_fully for an O_DIRECT fd: dst, len and offset must be aligned to
+// DIRECT_IO_ALIGNMENT. The kernel returns an unaligned count only at end of
+// file, so reading stops there rather than resubmitting at an unaligned
+// offset. Returns bytes read. Throws on I/O error.
+size_t pread_direct(int fd, uint8_t* dst, size_t len, off_t offset);
+
+// ============================================================================
+// io_uring (raw syscalls, no liburing dependency)
+// ============================================================================
+
+class IoUring {
+public:
+  // Called as each chunk lands: (byte offset within dst, bytes read)
+  using ChunkCallback = std::function<void(size_t, size_t)>;
+
+  // Throws std::system_error if the kernel refuses to create a ring
+  explicit IoUring(unsigned entries);
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  // Whether io_uring, including IORING_OP_READ (Linux 5.6+), is usable on
+  // this kernel/sandbox (probed once)
+  static bool supported();
+
+  // Pin buffers for IORING_OP_READ_FIXED. Returns false (and keeps using
+  // plain reads) if registration fails, e.g. under RLIMIT_MEMLOCK.
+  bool register_buffers(const std::vector<iovec>& buffers);
+  bool has_registered_buffers() const { return !registered_.empty(); }
+
+  // Read len bytes at offset into dst as chunk_bytes requests, keeping up
+  // to capacity() of them in flight. Short reads are resubmitted. Returns
+  // bytes read (less than len only at end of file).
+  size_t read_range(int fd, uint8_t* dst, size_t len, uint64_t offset,
+                    size_t chunk_bytes, const ChunkCallback& on_chunk = nullptr);
+
+  unsigned capacity() const { return entries_; }
+
+private:
+  int ring_fd_;
+  unsigned entries_;
+  unsigned to_submit_;
+
+  void* sq_ptr_;
+  size_t sq_len_;
+  void* cq_ptr_;
+  size_t cq_len_;
+  io_uring_sqe* sqes_;
+  size_t sqes_len_;
+
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_mask_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_mask_;
+  io_uring_cqe* cqes_;
+
+  std::vector<iovec> registered_;
+
+  void release();
+  void prep_read(int fd, uint8_t* dst, unsigned len, uint64_t offset, uint64_t user_data);
+  void enter(unsigned min_complete);
+  bool reap(uint64_t& user_data, int32_t& res);
+};
+
+} // namespace databento
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "dbn.hpp"
+#include "parser.hpp"
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// Merged Records
+// ============================================================================
+
+// One record of a merged stream: a zero-copy pointer into the source file's
+// mapping, valid while the reader is alive
+struct MergedRecord {
+  const uint8_t* record;
+  uint32_t source; // Index into the reader's paths
+};
+
+// ============================================================================
+// K-Way Timestamp Merge
+// ============================================================================
+
+// Memory-maps N DBN files of one schema (e.g. one per symbol per day) and
+// yields their records in ts_event order through a loser tree: each output
+// record costs one leaf-to-root replay of log2(N) comparisons against
+// stored losers, with no heap sift-down. Equal timestamps come out in source
+// order, and each file is assumed sorted by ts_event.
+class MergedReader {
+public:
+  static constexpr size_t DEFAULT_BATCH_RECORDS = 4096;
+
+  explicit MergedReader(const std::vector<std::string>& paths, RType schema = RType::Mbo);
+
+  size_t num_sources() const { return sources_.size(); }
+  const DbnParser& source(size_t index) const { return *sources_[index].parser; }
+  RType schema() const { return schema_; }
+
+  // Records across all sources / not yet emitted
+  size_t num_records() const { return total_records_; }
+  size_t remaining() const { return remaining_; }
+
+  // Fill out with the next records in ts_event order; returns how many
+  // were written (0 once every source is exhausted)
+  size_t next_batch(std::span<MergedRecord> out);
+
+  // Rewind every source to its first record
+  void reset();
+
+  // Whole merged stream as RecordType, batch by batch. Throws
+  // std::runtime_error if the records are smaller than RecordType.
+  template<typename RecordType, typename F>
+    requires std::invocable<F&, const RecordType&>
+  void parse_records(F&& callback, size_t batch_records = DEFAULT_BATCH_RECORDS) {
+    if (sizeof(RecordType) > record_size_) {
+      throw std::runtime_error("Record type is larger than the file's records");
+    }
+    std::vector<MergedRecord> batch(batch_records);
+    for (size_t n; (n = next_batch(batch)) > 0;) {
+      for (size_t i = 0; i < n; ++i) {
+        RecordType msg;
+        std::memcpy(&msg, batch[i].record, sizeof(RecordType));
+        callback(msg);
+      }
+    }
+  }
+
+  void parse_mbo(MboCallback callback);
+  void parse_trade(TradeCallback callback);
+
+  template<typename F>
+    requires std::invocable<F&, const MboMsg&>
+  void parse_mbo(F&& callback) {
+    parse_records<MboMsg>(callback);
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const TradeMsg&>
+  void parse_trade(F&& callback) {
+    parse_records<TradeMsg>(callback);
+  }
+
+private:
+  struct Source {
+    std::unique_ptr<DbnParser> parser;
+    const uint8_t* cursor;
+    const uint8_t* end;
+  };
+
+  std::vector<Source> sources_;
+  RType schema_;
+  size_t record_size_;
+  size_t total_records_ = 0;
+  size_t remaining_ = 0;
+
+  // Tournament over leaves padded to a power of two. keys_[s] is the
+  // ts_event at source s's cursor; exhausted (and padding) leaves are keyed
+  // UINT64_MAX with done_[s] set, so they lose to everything. tree_[1..leaves)
+  // holds the loser of each match, winner_ the overall winner.
+  size_t leaves_ = 0;
+  std::vector<uint64_t> keys_;
+  std::vector<uint8_t> done_;
+  std::vector<uint32_t> tree_;
+  uint32_t winner_ = 0;
+
+  bool beats(uint32_t a, uint32_t b) const {
+    if (keys_[a] != keys_[b]) {
+      return keys_[a] < keys_[b];
+    }
+    // A real record at UINT64_MAX still beats an exhausted source
+    return done_[a] != done_[b] ? done_[b] != 0 : a < b;
+  }
+
+  void load_key(uint32_t s);
+  void build_tree();
+};
+
+} // namespace databento
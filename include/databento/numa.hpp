@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// NUMA Topology (sysfs + raw syscalls, no libnuma dependency)
+// ============================================================================
+
+struct NumaTopology {
+  // CPUs of each node that this process may run on, node-major. Machines
+  // without /sys/devices/system/node report one node with every allowed CPU.
+  std::vector<std::vector<int>> node_cpus;
+  std::vector<int> node_ids; // Kernel node id of each node_cpus entry
+
+  size_t num_nodes() const { return node_cpus.size(); }
+  size_t num_cpus() const;
+
+  // Kernel id of the node holding cpu, or -1 if it isn't an allowed CPU
+  int node_of_cpu(int cpu) const;
+
+  // CPU for worker of num_workers: workers take CPUs in node-major order,
+  // so neighbouring workers (and the record ranges they own) share a node
+  int cpu_for_worker(size_t worker, size_t num_workers) const;
+
+  // Read once per process (honours the affinity mask at first use)
+  static const NumaTopology& system();
+};
+
+// Pin the calling thread to cpu. Returns false if the kernel refuses.
+bool pin_current_thread(int cpu);
+
+// Spread the pages of [addr, addr + len) round-robin over every node
+// (mbind MPOL_INTERLEAVE) before they are first touched. Only whole pages
+// inside the range are bound. Returns false on a single-node machine or if
+// the kernel refuses.
+bool interleave_pages(void* addr, size_t len, const NumaTopology& topology);
+
+} // namespace databento
@@ -1,7 +1,21 @@
 #pragma once
 
+#include "buffer.hpp"
+#include "columnar.hpp"
 #include "dbn.hpp"
+#include "instrument_index.hpp"
+#include "io.hpp"
+#include "numa.hpp"
+#include "perf.hpp"
+#include "time_index.hpp"
+#include "zstd.hpp"
+#include <chrono>
+#include <concepts>
 #include <functional>
+#include <future>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <memory>
@@ -14,6 +28,38 @@ namespace databento {
 
 using MboCallback = std::function<void(const MboMsg&)>;
 using TradeCallback = std::function<void(const TradeMsg&)>;
+using Mbp1Callback = std::function<void(const Mbp1Msg&)>;
+using Mbp10Callback = std::function<void(const Mbp10Msg&)>;
+
+// ============================================================================
+// Record Ranges (Parallel Scans)
+// ============================================================================
+
+// Half-open range of record indices [begin, end)
+struct RecordRange {
+  size_t begin;
+  size_t end;
+
+  size_t size() const { return end - begin; }
+};
+
+// Called in file order as whole records finish loading
+using RecordsReadyCallback = std::function<void(RecordRange)>;
+
+// Where load_numa() put one worker's records: the CPU that loaded (and
+// first-touched) them and that CPU's NUMA node
+struct NumaPlacement {
+  RecordRange range;
+  int cpu;
+  int node;
+};
+
+// Part of a time query; exact when every record in range is inside the
+// window, otherwise records must be checked one by one
+struct TimeSegment {
+  RecordRange range;
+  bool exact;
+};
 
 // ============================================================================
 // Fast DBN File Parser
@@ -21,7 +67,9 @@ using TradeCallback = std::function<void(const TradeMsg&)>;
 
 class DbnParser {
 public:
-  explicit DbnParser(const std::string& filepath);
+  // schema sets the record layout (Mbo, Trade, Mbp1 or Mbp10); throws
+  // std::invalid_argument for schemas without a record struct
+  explicit DbnParser(const std::string& filepath, RType schema = RType::Mbo);
   ~DbnParser();
 
   // Load file into memory (required before parsing)
@@ -30,16 +78,321 @@ public:
   // Load file using memory mapping (FASTEST - almost instant!)
   void load_with_mmap();
 
+  // Sliding-window mmap: with window_bytes > 0, load_with_mmap() stops
+  // advising WILLNEED over the whole file. Scans over this parser call
+  // advance_mmap_window() as they go instead: parse_*() (including the
+  // _range and _instrument variants), BatchProcessor, select_mbo(),
+  // BarBuilder::consume() and the Python iter_batches(). Each step prefetches window_bytes ahead of the cursor and drops
+  // the pages behind it (MADV_DONTNEED on the mapping, POSIX_FADV_DONTNEED
+  // on the file). Resident memory then stays near window_bytes however
+  // large the file is. Dropped pages fault back in from the file, so
+  // get_record() stays valid.
+  static constexpr size_t DEFAULT_MMAP_WINDOW_BYTES = 64 * 1024 * 1024; // 64MB
+  void set_mmap_window(size_t window_bytes) { mmap_window_ = window_bytes; }
+  size_t mmap_window() const { return mmap_window_; }
+
+  // Move the scan cursor to record_index. A no-op unless the file is mapped
+  // with a window, and cheap until the cursor has moved half a window.
+  void advance_mmap_window(size_t record_index) {
+    if (using_mmap_ && mmap_window_ > 0) {
+      slide_mmap_window(metadata_offset_ + record_index * record_size_);
+    }
+  }
+
+  // Records a scan may cover between advance_mmap_window() calls: half a
+  // window for a windowed mapping, otherwise the whole file
+  size_t mmap_window_step() const {
+    return using_mmap_ && mmap_window_ > 0 ? std::max<size_t>(mmap_window_ / 2 / record_size_, 1)
+                                           : std::max<size_t>(num_records_, 1);
+  }
+
+  // Bytes of the loaded data currently in memory (mincore)
+  size_t resident_bytes() const;
+
+  // Decompress a .dbn.zst file into memory on background threads
+  // (num_threads = 0 uses all cores for multi-frame files). Every load_*
+  // method detects zstd input and routes here, since compressed data cannot
+  // be parsed in place.
+  void load_zstd(size_t num_threads = 0);
+
+  // Load file with io_uring, keeping up to queue_depth chunk reads of
+  // chunk_bytes in flight. If given, on_records fires (in file order, on the
+  // calling thread) as records land, so parsing overlaps the remaining I/O.
+  // Falls back to chunked pread when io_uring is unavailable.
+  static constexpr size_t DEFAULT_IO_CHUNK_BYTES = 1024 * 1024; // 1MB
+  void load_with_io_uring(size_t queue_depth = 32,
+                          size_t chunk_bytes = DEFAULT_IO_CHUNK_BYTES,
+                          const RecordsReadyCallback& on_records = nullptr);
+
+  // Load with num_threads workers (0 = all cores) issuing positional reads
+  // of chunk_bytes (rounded down to whole records) into one buffer. If
+  // given, on_records fires in file order on the calling thread as chunks
+  // complete, so parsing overlaps the remaining reads. Unlike
+  // load_with_io_uring(), reads run on blocking threads, which keeps
+  // several requests in flight per device even without io_uring.
+  static constexpr size_t DEFAULT_PARALLEL_CHUNK_BYTES = 8 * 1024 * 1024; // 8MB
+  void load_parallel(size_t num_threads = 0,
+                     size_t chunk_bytes = DEFAULT_PARALLEL_CHUNK_BYTES,
+                     const RecordsReadyCallback& on_records = nullptr);
+
+  // Load with num_threads workers (0 = all cores), each pinned to a CPU
+  // (NumaTopology::cpu_for_worker) and pread()ing the records of its
+  // partition() range, so first touch puts every range on the node of the
+  // worker that will parse it. With interleave, pages are instead spread
+  // round-robin across nodes, for access that doesn't follow the partition.
+  // parallel_for_ranges() and parallel_parse_mbo() called with the same
+  // thread count pin their workers to the same CPUs.
+  void load_numa(size_t num_threads = 0, bool interleave = false);
+
+  // Worker layout of the last load_numa() (empty after other loads)
+  const std::vector<NumaPlacement>& numa_placement() const { return numa_placement_; }
+
+  // How the current data was loaded
+  IoBackend io_backend() const { return io_backend_; }
+
+  // Back the next load with huge pages to cut dTLB misses on large scans and
+  // random get_record() access. In-memory loads allocate through
+  // allocate_pages(); load_with_mmap() maps the file at a 2MB boundary and
+  // advises MADV_HUGEPAGE (hugetlb can't back a regular file, so HugeTlb
+  // behaves as Transparent there).
+  void set_huge_pages(HugePages mode) { huge_pages_ = mode; }
+  HugePages huge_pages() const { return huge_pages_; }
+
+  // What the loaded data got, and how much of it is on huge pages right
+  // now (reads /proc/self/smaps; THP promotion can lag the load)
+  PageBacking page_backing() const;
+  size_t huge_page_bytes() const { return databento::huge_page_bytes(data_, size_); }
+
   // Parse entire file with callback
   void parse_mbo(MboCallback callback);
   void parse_trade(TradeCallback callback);
 
+  // Parse entire file with an inlined callback (no std::function dispatch).
+  // Any lambda or functor binds here; the std::function overloads above
+  // remain for the Python bindings and other type-erased callers.
+  template<typename F>
+    requires std::invocable<F&, const MboMsg&>
+  void parse_mbo(F&& callback) {
+    parse_records<MboMsg>(callback);
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const TradeMsg&>
+  void parse_trade(F&& callback) {
+    parse_records<TradeMsg>(callback);
+  }
+
+  // MBP files (parser constructed with RType::Mbp1 / RType::Mbp10)
+  void parse_mbp1(Mbp1Callback callback);
+  void parse_mbp10(Mbp10Callback callback);
+
+  template<typename F>
+    requires std::invocable<F&, const Mbp1Msg&>
+  void parse_mbp1(F&& callback) {
+    parse_records<Mbp1Msg>(callback);
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const Mbp10Msg&>
+  void parse_mbp10(F&& callback) {
+    parse_records<Mbp10Msg>(callback);
+  }
+
+  // Parse entire file as RecordType; throws std::runtime_error if the
+  // file's records are smaller than RecordType
+  template<typename RecordType, typename F>
+    requires std::invocable<F&, const RecordType&>
+  void parse_records(F&& callback) {
+    check_record_type(sizeof(RecordType));
+    if (!data_) {
+      load_into_memory();
+    }
+
+    const size_t step = mmap_window_step();
+    const uint8_t* ptr = data_ + metadata_offset_;
+    for (size_t begin = 0; begin < num_records_; begin += step) {
+      advance_mmap_window(begin);
+      const size_t end = std::min(begin + step, num_records_);
+      for (size_t i = begin; i < end; ++i) {
+        RecordType msg;
+        std::memcpy(&msg, ptr, sizeof(RecordType));
+        callback(msg);
+        ptr += record_size_;
+      }
+    }
+  }
+
+  // Split records into num_parts contiguous ranges whose boundaries fall on
+  // multiples of PARALLEL_CHUNK_RECORDS (192KB of records, page-multiple)
+  static constexpr size_t PARALLEL_CHUNK_RECORDS = 4096;
+  std::vector<RecordRange> partition(size_t num_parts) const;
+
+  // Run fn(thread_index, range) on num_threads workers (0 = all cores),
+  // one contiguous range per worker. Exceptions are rethrown after join.
+  // After load_numa() with the same thread count, worker t runs on the CPU
+  // that loaded range t.
+  void parallel_for_ranges(
+      size_t num_threads,
+      const std::function<void(size_t, RecordRange)>& fn);
+
+  // Parallel scan: each worker folds its range into a private copy of init
+  // with per_record(acc, msg), then partials are merged in range order with
+  // reduce(total, partial). The inner loop is inlined per worker.
+  template<typename Acc, typename PerRecord, typename Reduce>
+    requires std::invocable<PerRecord&, Acc&, const MboMsg&> &&
+             std::invocable<Reduce&, Acc&, Acc&>
+  Acc parallel_parse_mbo(size_t num_threads, PerRecord&& per_record,
+                         Reduce&& reduce, Acc init = Acc{}) {
+    if (!data_) {
+      load_into_memory();
+    }
+
+    // Pad accumulators to a cache line so workers don't false-share
+    struct alignas(64) Slot {
+      Acc acc;
+    };
+
+    const size_t workers = resolve_thread_count(num_threads);
+    std::vector<Slot> slots(workers, Slot{init});
+
+    parallel_for_ranges(workers, [&](size_t t, RecordRange range) {
+      Acc& acc = slots[t].acc;
+      const uint8_t* ptr = data_ + metadata_offset_ + range.begin * record_size_;
+      for (size_t i = range.begin; i < range.end; ++i) {
+        MboMsg msg;
+        std::memcpy(&msg, ptr, sizeof(MboMsg));
+        per_record(acc, msg);
+        ptr += record_size_;
+      }
+    });
+
+    Acc total = std::move(slots[0].acc);
+    for (size_t t = 1; t < workers; ++t) {
+      reduce(total, slots[t].acc);
+    }
+    return total;
+  }
+
+  // Time-range queries over [t0, t1) on ts_event. Without a time index,
+  // ts_event is assumed non-decreasing and searched in place (loading with
+  // mmap if needed, so only probed pages are read). Once build_time_index()
+  // has run, queries use its per-block bounds and stay exact for files that
+  // aren't sorted.
+
+  // First record, in file order, with ts_event >= ts (num_records() if none)
+  size_t lower_bound_time(uint64_t ts);
+
+  // Record ranges, in file order, covering every record in [t0, t1)
+  std::vector<TimeSegment> time_segments(uint64_t t0, uint64_t t1);
+
+  void parse_mbo_range(uint64_t t0, uint64_t t1, MboCallback callback);
+  void parse_trade_range(uint64_t t0, uint64_t t1, TradeCallback callback);
+
+  template<typename F>
+    requires std::invocable<F&, const MboMsg&>
+  void parse_mbo_range(uint64_t t0, uint64_t t1, F&& callback) {
+    const std::vector<TimeSegment> segments = time_segments(t0, t1);
+    const size_t step = mmap_window_step();
+    for (const TimeSegment& segment : segments) {
+      const uint8_t* ptr = data_ + metadata_offset_ + segment.range.begin * record_size_;
+      size_t next_step = segment.range.begin;
+      for (size_t i = segment.range.begin; i < segment.range.end; ++i) {
+        if (i == next_step) {
+          advance_mmap_window(i);
+          next_step += step;
+        }
+        MboMsg msg;
+        std::memcpy(&msg, ptr, sizeof(MboMsg));
+        if (segment.exact || (msg.ts_event >= t0 && msg.ts_event < t1)) {
+          callback(msg);
+        }
+        ptr += record_size_;
+      }
+    }
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const TradeMsg&>
+  void parse_trade_range(uint64_t t0, uint64_t t1, F&& callback) {
+    const std::vector<TimeSegment> segments = time_segments(t0, t1);
+    const size_t step = mmap_window_step();
+    for (const TimeSegment& segment : segments) {
+      const uint8_t* ptr = data_ + metadata_offset_ + segment.range.begin * record_size_;
+      size_t next_step = segment.range.begin;
+      for (size_t i = segment.range.begin; i < segment.range.end; ++i) {
+        if (i == next_step) {
+          advance_mmap_window(i);
+          next_step += step;
+        }
+        TradeMsg msg;
+        std::memcpy(&msg, ptr, sizeof(TradeMsg));
+        if (segment.exact || (msg.ts_event >= t0 && msg.ts_event < t1)) {
+          callback(msg);
+        }
+        ptr += record_size_;
+      }
+    }
+  }
+
+  // Scan ts_event once into a sparse min/max index, cached for later
+  // queries (rebuilt only if block_records changes)
+  const TimeIndex& build_time_index(size_t block_records = TimeIndex::DEFAULT_BLOCK_RECORDS);
+  const TimeIndex* time_index() const { return time_index_.get(); }
+
+  // Per-instrument scans. instrument_index() loads the sidecar
+  // (InstrumentIndex::sidecar_path) when it matches this file, otherwise
+  // builds the index in one pass and, if persist is set, writes the sidecar
+  // (best effort; skipped when the directory isn't writable). Scans then
+  // touch only the pages holding that instrument's records, unless the
+  // file is mapped with a window, whose readahead covers every page.
+  const InstrumentIndex& instrument_index(bool persist = true);
+
+  void parse_mbo_instrument(uint32_t instrument_id, MboCallback callback);
+  void parse_trade_instrument(uint32_t instrument_id, TradeCallback callback);
+
+  template<typename F>
+    requires std::invocable<F&, const MboMsg&>
+  void parse_mbo_instrument(uint32_t instrument_id, F&& callback) {
+    const InstrumentIndex& index = instrument_index();
+    const uint8_t* records = data_ + metadata_offset_;
+    const size_t step = mmap_window_step();
+    size_t next_step = 0;
+    index.for_each(instrument_id, [&](size_t i) {
+      if (i >= next_step) {
+        advance_mmap_window(i);
+        next_step = i + step;
+      }
+      MboMsg msg;
+      std::memcpy(&msg, records + i * record_size_, sizeof(MboMsg));
+      callback(msg);
+    });
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const TradeMsg&>
+  void parse_trade_instrument(uint32_t instrument_id, F&& callback) {
+    const InstrumentIndex& index = instrument_index();
+    const uint8_t* records = data_ + metadata_offset_;
+    const size_t step = mmap_window_step();
+    size_t next_step = 0;
+    index.for_each(instrument_id, [&](size_t i) {
+      if (i >= next_step) {
+        advance_mmap_window(i);
+        next_step = i + step;
+      }
+      TradeMsg msg;
+      std::memcpy(&msg, records + i * record_size_, sizeof(TradeMsg));
+      callback(msg);
+    });
+  }
+
   // Direct memory access (zero-copy, maximum performance)
   const uint8_t* data() const { return data_; }
   size_t size() const { return size_; }
   size_t num_records() const { return num_records_; }
   size_t record_size() const { return record_size_; }
   size_t metadata_offset() const { return metadata_offset_; }
+  RType schema() const { return schema_; }
 
   // Get record at index (zero-copy)
   const uint8_t* get_record(size_t index) const;
@@ -52,14 +405,180 @@ private:
   const uint8_t* data_;
   size_t size_;
   size_t metadata_offset_;
+  RType schema_;
   size_t record_size_;
   size_t num_records_;
-  std::vector<uint8_t> buffer_;
+  AlignedBuffer<uint8_t> buffer_;
   void* mmap_addr_;
+  size_t mmap_len_;
   int mmap_fd_;
   bool using_mmap_;
+  IoBackend io_backend_;
+  HugePages huge_pages_;
+  PageBacking mmap_backing_;
+  size_t mmap_window_;             // Sliding window bytes (0 = whole file)
+  size_t window_pos_;              // Cursor of the last window step
+  size_t window_ahead_;            // End of the range advised WILLNEED
+  size_t window_dropped_;          // End of the range dropped behind
+  std::vector<NumaPlacement> numa_placement_;
+  // Built lazily over the loaded records; every load_* drops them
+  std::unique_ptr<TimeIndex> time_index_;
+  std::unique_ptr<InstrumentIndex> instrument_index_;
   
   void cleanup_mmap();
+  void reset_loaded();
+  void slide_mmap_window(size_t offset);
+  uint8_t* prepare_buffer(size_t bytes);
+  void check_record_type(size_t record_bytes) const;
+  bool load_if_compressed();
+  void load_for_seek();
+  size_t indexed_lower_bound(uint64_t ts) const;
+  static size_t resolve_thread_count(size_t num_threads);
+};
+
+// ============================================================================
+// Streaming Reader (Bounded Memory)
+// ============================================================================
+
+// Reads a DBN file through two fixed-size windows: while the caller parses
+// one window, the next is read in the background. Resident memory stays at
+// memory_budget no matter how large the file is. Windows are sized in bytes,
+// so a record split across a window edge is stitched together in front of
+// the following window.
+class DbnStream {
+public:
+  static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024; // 64MB
+  static constexpr size_t DIRECT_QUEUE_DEPTH = 8; // In-flight reads per window (and ring depth)
+
+  // backend may be IoBackend::Pread (default) or IoBackend::IoUring; the
+  // latter splits each window into queued reads into registered buffers and
+  // falls back to pread when io_uring is unavailable. zstd input is detected
+  // and decoded on a background thread instead (backend becomes Zstd), in
+  // blocks of memory_budget / 4 however large the file's frames are.
+  // IoBackend::Direct reads with O_DIRECT so a one-pass scan doesn't evict
+  // the page cache: windows are block-aligned reads (queued on io_uring, or
+  // issued from DIRECT_QUEUE_DEPTH threads) that start at offset 0 and skip
+  // the metadata in memory. Filesystems without O_DIRECT (tmpfs) fall back
+  // to pread that drops each window from the cache once read (backend
+  // becomes Pread).
+  explicit DbnStream(const std::string& filepath,
+                     size_t memory_budget = DEFAULT_MEMORY_BUDGET,
+                     IoBackend backend = IoBackend::Pread,
+                     RType schema = RType::Mbo);
+  ~DbnStream();
+
+  DbnStream(const DbnStream&) = delete;
+  DbnStream& operator=(const DbnStream&) = delete;
+
+  // Open file and start prefetching the first window (called lazily)
+  void open();
+
+  // Restart from the first record
+  void rewind();
+
+  // Advance to the next window of whole records. Returns false at end of
+  // file. The records stay valid until the next call.
+  // For zstd input num_records() is 0: frames are decoded in order without
+  // first scanning the file for their sizes.
+  bool next_window(const uint8_t*& records, size_t& count);
+
+  // Parse entire file with callback (rewinds first)
+  void parse_mbo(MboCallback callback);
+  void parse_trade(TradeCallback callback);
+
+  template<typename F>
+    requires std::invocable<F&, const MboMsg&>
+  void parse_mbo(F&& callback) {
+    parse_records<MboMsg>(callback);
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const TradeMsg&>
+  void parse_trade(F&& callback) {
+    parse_records<TradeMsg>(callback);
+  }
+
+  void parse_mbp1(Mbp1Callback callback);
+  void parse_mbp10(Mbp10Callback callback);
+
+  template<typename F>
+    requires std::invocable<F&, const Mbp1Msg&>
+  void parse_mbp1(F&& callback) {
+    parse_records<Mbp1Msg>(callback);
+  }
+
+  template<typename F>
+    requires std::invocable<F&, const Mbp10Msg&>
+  void parse_mbp10(F&& callback) {
+    parse_records<Mbp10Msg>(callback);
+  }
+
+  template<typename RecordType, typename F>
+    requires std::invocable<F&, const RecordType&>
+  void parse_records(F&& callback) {
+    if (sizeof(RecordType) > record_size_) {
+      throw std::runtime_error("Record type is larger than this stream's records");
+    }
+    rewind();
+
+    const uint8_t* records;
+    size_t count;
+    while (next_window(records, count)) {
+      const uint8_t* ptr = records;
+      for (size_t i = 0; i < count; ++i) {
+        RecordType msg;
+        std::memcpy(&msg, ptr, sizeof(RecordType));
+        callback(msg);
+        ptr += record_size_;
+      }
+    }
+  }
+
+  size_t size() const { return size_; }
+  size_t num_records() const { return num_records_; }
+  size_t record_size() const { return record_size_; }
+  size_t metadata_offset() const { return metadata_offset_; }
+  size_t memory_budget() const { return memory_budget_; }
+  size_t window_bytes() const { return window_bytes_; }
+  IoBackend io_backend() const { return backend_; }
+  RType schema() const { return schema_; }
+
+private:
+  std::string filepath_;
+  int fd_;
+  size_t size_;
+  size_t metadata_offset_;
+  RType schema_;
+  size_t record_size_;
+  size_t num_records_;
+  size_t memory_budget_;
+  size_t window_bytes_;
+  IoBackend backend_;
+  std::unique_ptr<IoUring> uring_;
+
+  std::vector<uint8_t> buffers_[2]; // record_size_ headroom + window_bytes_
+  size_t window_offset_[2];         // Where reads land in each buffer
+  int direct_fd_;                   // O_DIRECT descriptor (Direct backend)
+  bool drop_behind_;                // Evict windows from the page cache
+  size_t fill_;                     // Buffer the pending read lands in
+  size_t file_pos_;                 // Next byte offset to read
+  size_t end_pos_;                  // End of last whole record
+  size_t carry_;                    // Bytes of a straddling record
+  const uint8_t* carry_src_;        // Where those bytes sit in the last window
+  bool consumed_;                   // Any window handed out since rewind
+  std::future<size_t> pending_;
+
+  // zstd input: decoded blocks replace the file windows
+  std::unique_ptr<ZstdDecoder> decoder_;
+  ZstdDecoder::Block block_;
+  std::vector<uint8_t> carry_buf_;
+  size_t skip_;                     // Metadata bytes still to skip (zstd, direct)
+
+  void start_decoder();
+  bool next_zstd_window(const uint8_t*& records, size_t& count);
+  void schedule_read();
+  void schedule_direct_read(uint8_t* dst, size_t len, off_t offset);
+  void wait_pending();
 };
 
 // ============================================================================
@@ -82,32 +601,211 @@ public:
 
     const size_t total = parser.num_records();
     const size_t rec_size = parser.record_size();
+    check_record_size<RecordType>(rec_size);
+
+    std::vector<RecordType> batch;
+    batch.reserve(std::min(batch_size_, total));
 
     for (size_t i = 0; i < total; i += batch_size_) {
       const size_t batch_count = std::min(batch_size_, total - i);
-      std::vector<RecordType> batch;
-      batch.reserve(batch_count);
+      batch.clear();
 
       const uint8_t* batch_data = parser.get_batch(i, batch_count);
       
       for (size_t j = 0; j < batch_count; ++j) {
         const uint8_t* record = batch_data + (j * rec_size);
-        if constexpr (std::is_same_v<RecordType, MboMsg>) {
-          batch.push_back(parse_mbo(record));
-        } else if constexpr (std::is_same_v<RecordType, TradeMsg>) {
-          batch.push_back(parse_trade(record));
+        batch.push_back(parse_record<RecordType>(record));
+      }
+
+      callback(batch);
+    }
+  }
+
+  // Process a streamed file in batches (batches may span stream windows)
+  template<typename RecordType, typename Callback>
+  void process_batches(DbnStream& stream, Callback callback) {
+    stream.rewind();
+
+    std::vector<RecordType> batch;
+    batch.reserve(std::min(batch_size_, stream.num_records()));
+
+    const size_t rec_size = stream.record_size();
+    check_record_size<RecordType>(rec_size);
+    const uint8_t* records;
+    size_t count;
+
+    while (stream.next_window(records, count)) {
+      for (size_t j = 0; j < count; ++j) {
+        const uint8_t* record = records + (j * rec_size);
+        batch.push_back(parse_record<RecordType>(record));
+
+        if (batch.size() == batch_size_) {
+          callback(batch);
+          batch.clear();
         }
       }
+    }
 
+    if (!batch.empty()) {
       callback(batch);
     }
   }
 
+  // Zero-copy batches: callback(std::span<const RecordType>) views records
+  // directly in parser.data(). Records are copied (into one reused scratch
+  // buffer) only if the record layout or alignment rules out a direct view.
+  // An unloaded parser is memory-mapped rather than read into memory.
+  template<typename RecordType, typename Callback>
+  void process_batch_spans(DbnParser& parser, Callback callback) {
+    if (!parser.data()) {
+      parser.load_with_mmap();
+    }
+
+    const size_t total = parser.num_records();
+    const size_t rec_size = parser.record_size();
+    check_record_size<RecordType>(rec_size);
+    std::vector<RecordType> scratch;
+
+    for (size_t i = 0; i < total; i += batch_size_) {
+      const size_t batch_count = std::min(batch_size_, total - i);
+      parser.advance_mmap_window(i);
+      const uint8_t* batch_data = parser.get_batch(i, batch_count);
+      callback(view_records<RecordType>(batch_data, batch_count, rec_size, scratch));
+    }
+  }
+
+  // Zero-copy batches over a stream. Spans view the current window, so a
+  // batch never spans two windows and may be shorter than batch_size().
+  template<typename RecordType, typename Callback>
+  void process_batch_spans(DbnStream& stream, Callback callback) {
+    stream.rewind();
+
+    const size_t rec_size = stream.record_size();
+    check_record_size<RecordType>(rec_size);
+    std::vector<RecordType> scratch;
+    const uint8_t* records;
+    size_t count;
+
+    while (stream.next_window(records, count)) {
+      for (size_t i = 0; i < count; i += batch_size_) {
+        const size_t batch_count = std::min(batch_size_, count - i);
+        callback(view_records<RecordType>(records + i * rec_size, batch_count, rec_size, scratch));
+      }
+    }
+  }
+
+  // Columnar batches: callback(const MboColumns&) receives the selected
+  // fields (COL_* bits) transposed into per-field arrays. The column buffers
+  // are reused from batch to batch.
+  template<typename Callback>
+  void process_columns(DbnParser& parser, uint32_t columns, Callback callback) {
+    if (!parser.data()) {
+      parser.load_with_mmap();
+    }
+
+    const size_t total = parser.num_records();
+    const size_t rec_size = parser.record_size();
+    check_record_size<MboMsg>(rec_size);
+    MboColumns batch;
+
+    for (size_t i = 0; i < total; i += batch_size_) {
+      const size_t batch_count = std::min(batch_size_, total - i);
+      parser.advance_mmap_window(i);
+      decode_mbo_columns(parser.get_batch(i, batch_count), batch_count, rec_size, columns, batch);
+      callback(static_cast<const MboColumns&>(batch));
+    }
+  }
+
+  // Columnar batches over a stream (a batch never spans two windows)
+  template<typename Callback>
+  void process_columns(DbnStream& stream, uint32_t columns, Callback callback) {
+    stream.rewind();
+
+    const size_t rec_size = stream.record_size();
+    check_record_size<MboMsg>(rec_size);
+    MboColumns batch;
+    const uint8_t* records;
+    size_t count;
+
+    while (stream.next_window(records, count)) {
+      for (size_t i = 0; i < count; i += batch_size_) {
+        const size_t batch_count = std::min(batch_size_, count - i);
+        decode_mbo_columns(records + i * rec_size, batch_count, rec_size, columns, batch);
+        callback(static_cast<const MboColumns&>(batch));
+      }
+    }
+  }
+
+  // MBP ladder batches: callback(const MbpLadders&) receives the best
+  // `levels` bid/ask levels of each batch (1 for MBP-1, up to 10 for
+  // MBP-10) as level-major columns, reused from batch to batch
+  template<typename Callback>
+  void process_ladders(DbnParser& parser, size_t levels, Callback callback) {
+    if (!parser.data()) {
+      parser.load_with_mmap();
+    }
+
+    const size_t total = parser.num_records();
+    const size_t rec_size = parser.record_size();
+    MbpLadders batch;
+
+    for (size_t i = 0; i < total; i += batch_size_) {
+      const size_t batch_count = std::min(batch_size_, total - i);
+      parser.advance_mmap_window(i);
+      decode_mbp_ladders(parser.get_batch(i, batch_count), batch_count, rec_size, levels, batch);
+      callback(static_cast<const MbpLadders&>(batch));
+    }
+  }
+
+  template<typename Callback>
+  void process_ladders(DbnStream& stream, size_t levels, Callback callback) {
+    stream.rewind();
+
+    const size_t rec_size = stream.record_size();
+    MbpLadders batch;
+    const uint8_t* records;
+    size_t count;
+
+    while (stream.next_window(records, count)) {
+      for (size_t i = 0; i < count; i += batch_size_) {
+        const size_t batch_count = std::min(batch_size_, count - i);
+        decode_mbp_ladders(records + i * rec_size, batch_count, rec_size, levels, batch);
+        callback(static_cast<const MbpLadders&>(batch));
+      }
+    }
+  }
+
   void set_batch_size(size_t size) { batch_size_ = size; }
   size_t batch_size() const { return batch_size_; }
 
 private:
   size_t batch_size_;
+
+  template<typename RecordType>
+  static void check_record_size(size_t rec_size) {
+    if (sizeof(RecordType) > rec_size) {
+      throw std::runtime_error("Record type is larger than the file's records");
+    }
+  }
+
+  template<typename RecordType>
+  static std::span<const RecordType> view_records(const uint8_t* data, size_t count,
+                                                  size_t rec_size,
+                                                  std::vector<RecordType>& scratch) {
+    static_assert(std::is_trivially_copyable_v<RecordType>);
+
+    // Packed records (alignof == 1) can always be viewed in place
+    if (rec_size == sizeof(RecordType) &&
+        reinterpret_cast<uintptr_t>(data) % alignof(RecordType) == 0) {
+      return {reinterpret_cast<const RecordType*>(data), count};
+    }
+
+    scratch.resize(count);
+    for (size_t j = 0; j < count; ++j) {
+      std::memcpy(&scratch[j], data + j * rec_size, sizeof(RecordType));
+    }
+    return {scratch.data(), count};
+  }
 };
 
 // ============================================================================
@@ -115,19 +813,122 @@ private:
 // ============================================================================
 
 struct ParseStats {
-  uint64_t total_records;
-  double elapsed_seconds;
-  double records_per_second;
-  double throughput_gbps;
+  uint64_t total_records = 0;
+  uint64_t total_bytes = 0;       // Record bytes (num_records * record_size)
+  double elapsed_seconds = 0;     // load_seconds + parse_seconds
+  double load_seconds = 0;        // Open and load the file into memory
+  double parse_seconds = 0;       // Run the callbacks over resident data
+  double records_per_second = 0;  // Over elapsed_seconds
+  double throughput_gbps = 0;     // total_bytes over elapsed_seconds
+
+  // Page backing of the loaded data, and the part on huge pages after the
+  // parse (measured only when huge pages were requested)
+  PageBacking page_backing = PageBacking::Heap;
+  size_t huge_page_bytes = 0;
+
+  // Sliding mmap window (0: loaded into memory, including a .dbn.zst
+  // decoded despite a window), and how much of the file was still resident
+  // after the parse (measured only with a window)
+  size_t mmap_window_bytes = 0;
+  size_t resident_bytes = 0;
+
+  // Hardware counters per phase, when requested and the kernel allows it
+  PerfSample load_counters;
+  PerfSample parse_counters;
 
   void print() const;
 };
 
+// Load filepath into memory and run parse(parser), timing the two phases
+// separately. With hw_counters, also samples PerfCounters around each
+// phase (left empty if perf_event_open is unavailable). huge_pages sets
+// the load buffer's backing (see DbnParser::set_huge_pages). A non-zero
+// mmap_window maps the file with a sliding window of that many bytes
+// instead of loading it (see DbnParser::set_mmap_window).
+template<typename Parse>
+  requires std::invocable<Parse&, DbnParser&>
+ParseStats measure_parse_file(const std::string& filepath, Parse&& parse,
+                              bool hw_counters = false,
+                              HugePages huge_pages = HugePages::Off,
+                              size_t mmap_window = 0) {
+  std::optional<PerfCounters> counters;
+  if (hw_counters) {
+    counters.emplace();
+  }
+  ParseStats stats;
+
+  auto start = std::chrono::steady_clock::now();
+  if (counters) {
+    counters->start();
+  }
+  DbnParser parser(filepath);
+  parser.set_huge_pages(huge_pages);
+  if (mmap_window > 0) {
+    parser.set_mmap_window(mmap_window);
+    parser.load_with_mmap();
+  } else {
+    parser.load_into_memory();
+  }
+  if (counters) {
+    stats.load_counters = counters->stop();
+  }
+  auto loaded = std::chrono::steady_clock::now();
+
+  if (counters) {
+    counters->start();
+  }
+  parse(parser);
+  if (counters) {
+    stats.parse_counters = counters->stop();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  stats.total_records = parser.num_records();
+  stats.total_bytes = parser.num_records() * parser.record_size();
+  stats.load_seconds = std::chrono::duration<double>(loaded - start).count();
+  stats.parse_seconds = std::chrono::duration<double>(end - loaded).count();
+  stats.elapsed_seconds = stats.load_seconds + stats.parse_seconds;
+  stats.records_per_second = stats.total_records / stats.elapsed_seconds;
+  stats.throughput_gbps = stats.total_bytes / (stats.elapsed_seconds * 1024 * 1024 * 1024);
+  stats.page_backing = parser.page_backing();
+  if (huge_pages != HugePages::Off) {
+    stats.huge_page_bytes = parser.huge_page_bytes();
+  }
+  if (mmap_window > 0 && parser.io_backend() == IoBackend::Mmap) {
+    stats.mmap_window_bytes = mmap_window;
+    stats.resident_bytes = parser.resident_bytes();
+  }
+  return stats;
+}
+
 // ============================================================================
 // High-Level Utility Functions
 // ============================================================================
 
-ParseStats parse_file_mbo(const std::string& filepath, MboCallback callback);
-ParseStats parse_file_trade(const std::string& filepath, TradeCallback callback);
+ParseStats parse_file_mbo(const std::string& filepath, MboCallback callback,
+                          bool hw_counters = false, HugePages huge_pages = HugePages::Off,
+                          size_t mmap_window = 0);
+ParseStats parse_file_trade(const std::string& filepath, TradeCallback callback,
+                            bool hw_counters = false, HugePages huge_pages = HugePages::Off,
+                            size_t mmap_window = 0);
+
+// Inlined-callback variants of the above
+template<typename F>
+  requires std::invocable<F&, const MboMsg&>
+ParseStats parse_file_mbo(const std::string& filepath, F&& callback, bool hw_counters = false,
+                          HugePages huge_pages = HugePages::Off, size_t mmap_window = 0) {
+  return measure_parse_file(
+      filepath, [&](DbnParser& parser) { parser.parse_mbo(callback); }, hw_counters,
+      huge_pages, mmap_window);
+}
+
+template<typename F>
+  requires std::invocable<F&, const TradeMsg&>
+ParseStats parse_file_trade(const std::string& filepath, F&& callback, bool hw_counters = false,
+                            HugePages huge_pages = HugePages::Off, size_t mmap_window = 0) {
+  return measure_parse_file(
+      filepath, [&](DbnParser& parser) { parser.parse_trade(callback); }, hw_counters,
+      huge_pages, mmap_window);
+}
 
 } // namespace databento
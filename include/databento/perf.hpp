@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace databento {
+
+// ============================================================================
+// Hardware Performance Counters (perf_event_open, raw syscalls)
+// ============================================================================
+
+// Counter deltas over one measured phase. A counter the kernel or CPU
+// doesn't provide (no PMU in a VM, perf_event_paranoid too strict) is
+// left empty. Values are scaled up if the kernel had to multiplex.
+struct PerfSample {
+  std::optional<uint64_t> cycles;
+  std::optional<uint64_t> instructions;
+  std::optional<uint64_t> llc_misses;     // Last-level cache read misses
+  std::optional<uint64_t> dtlb_misses;    // Data TLB read misses
+  std::optional<uint64_t> branch_misses;
+
+  bool valid() const { return cycles.has_value() || instructions.has_value(); }
+
+  // Instructions per cycle; 0 without both counters
+  double ipc() const;
+};
+
+// Counts the calling thread only (user and, when permitted, kernel time).
+// Cycles leads a counter group so the ratios share one measurement window;
+// events the PMU can't fit in the group are counted on their own.
+// Construction never throws: unavailable events are skipped.
+class PerfCounters {
+public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Whether the CPU cycle counter can be opened here (probed once)
+  static bool supported();
+
+  // Whether any counter opened
+  bool available() const;
+
+  // Reset and start counting
+  void start();
+
+  // Stop counting and return the deltas since start()
+  PerfSample stop();
+
+private:
+  static constexpr int NUM_EVENTS = 5;
+  int fds_[NUM_EVENTS];
+  bool grouped_[NUM_EVENTS]; // Member of the cycles group (event 0 leads it)
+};
+
+} // namespace databento
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "dbn.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace databento {
+
+// ============================================================================
+// Synthetic MBO Data
+// ============================================================================
+
+// Parameters of a synthetic MBO stream. The same config (including seed)
+// always produces the same bytes, whatever the thread count.
+struct SyntheticConfig {
+  // Records are generated in independent chunks of this many, one RNG
+  // stream per chunk, so chunks can be produced in parallel
+  static constexpr size_t CHUNK_RECORDS = size_t{1} << 20;
+
+  uint64_t seed = 1;
+  size_t num_records = 1'000'000;
+
+  // Instrument mix: instrument k (0-based) is picked with weight
+  // 1 / (k + 1), so a few instruments dominate as in a real feed
+  uint32_t num_instruments = 16;
+  uint32_t first_instrument_id = 1;
+  size_t max_orders_per_instrument = 128;
+
+  // ts_event = start_ts + i * mean_gap_ns + jitter in [0, mean_gap_ns),
+  // strictly increasing in record index i
+  uint64_t start_ts = 1'704'067'200'000'000'000ULL; // 2024-01-01
+  uint64_t mean_gap_ns = 1000;
+
+  // Prices move in ticks around base_price (1e-9 fixed point)
+  int64_t base_price = 4'500'000'000'000;
+  int64_t tick = 250'000'000;
+
+  // Relative event weights. A trade is written as Trade, Fill and the
+  // Cancel that takes the filled size off the resting order.
+  double add_weight = 0.45;
+  double cancel_weight = 0.35;
+  double modify_weight = 0.12;
+  double trade_weight = 0.08;
+};
+
+// Fill out with records [chunk_index * CHUNK_RECORDS, ...) of the stream.
+// out.size() must be the chunk's length (CHUNK_RECORDS, or less for the
+// last chunk). Each chunk is a self-contained order lifecycle: every order
+// it adds is cancelled or filled within the chunk, and the books it builds
+// never cross.
+void generate_mbo_chunk(const SyntheticConfig& config, size_t chunk_index,
+                        std::span<MboMsg> out);
+
+// Write a DBN file (200-byte zeroed metadata block, then the records),
+// generating chunks on num_threads workers (0 = all cores) and writing
+// each with one positional write
+void write_synthetic_dbn(const std::string& path, const SyntheticConfig& config,
+                         size_t num_threads = 0);
+
+} // namespace databento
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// Timestamp Search
+// ============================================================================
+
+// Index of the first of count records (rec_size bytes apart) whose ts_event
+// is >= ts, assuming ts_event is non-decreasing. Interpolation search,
+// interleaved with bisection so skewed timestamps can't degrade it past
+// O(log n) probes.
+size_t lower_bound_ts(const uint8_t* records, size_t count, size_t rec_size, uint64_t ts);
+
+// ============================================================================
+// Sparse Time Index
+// ============================================================================
+
+// Min/max ts_event per block of block_records records. Lets time queries
+// skip whole blocks in files whose timestamps are only roughly ordered
+// (e.g. ts_event in a file sorted by ts_recv).
+struct TimeIndex {
+  static constexpr size_t DEFAULT_BLOCK_RECORDS = 4096;
+
+  size_t block_records = DEFAULT_BLOCK_RECORDS;
+  size_t num_records = 0;
+  std::vector<uint64_t> min_ts;
+  std::vector<uint64_t> max_ts;
+  bool sorted = true; // ts_event non-decreasing across the whole file
+
+  size_t num_blocks() const { return min_ts.size(); }
+
+  // One pass over the records
+  static TimeIndex build(const uint8_t* records, size_t count, size_t rec_size,
+                         size_t block_records = DEFAULT_BLOCK_RECORDS);
+};
+
+} // namespace databento
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace databento {
+
+// ============================================================================
+// zstd Detection
+// ============================================================================
+
+constexpr uint32_t ZSTD_FRAME_MAGIC = 0xFD2FB528;
+
+// A declared decompressed size is trusted up to this multiple of the
+// compressed size (well above what market data compresses to); beyond it
+// buffers grow only as output actually arrives
+constexpr size_t ZSTD_PREALLOC_RATIO = 32;
+
+// True if data starts with a zstd frame (regular or skippable)
+bool is_zstd_frame(const uint8_t* data, size_t size);
+
+// True if the file starts with a zstd frame (e.g. .dbn.zst)
+bool is_zstd_file(const std::string& filepath);
+
+// Whether the library was built with libzstd (DATABENTO_HAS_ZSTD)
+bool zstd_supported();
+
+// ============================================================================
+// Pipelined zstd Decoder
+// ============================================================================
+
+// Decompresses a zstd file on background threads into a bounded queue of
+// output blocks, handed out in stream order. With num_threads = 1, or a
+// single-frame file, one thread decodes into block_bytes-sized blocks, so
+// at most queue_depth + 2 blocks of block_bytes exist at once. A multi-frame
+// file with more threads is decoded frame-parallel, one block per frame:
+// blocks are then as large as the frames. A frame's declared size is only
+// preallocated up to 32x its compressed size; past that the block grows as
+// output actually arrives, so a corrupt header can't force a huge
+// allocation.
+class ZstdDecoder {
+public:
+  static constexpr size_t DEFAULT_BLOCK_BYTES = 4 * 1024 * 1024; // 4MB
+  static constexpr size_t DEFAULT_QUEUE_DEPTH = 4;
+
+  // Decompressed bytes live at storage.data() + offset; the offset bytes in
+  // front are headroom the consumer may write into (e.g. to stitch records)
+  struct Block {
+    std::vector<uint8_t> storage;
+    size_t offset = 0;
+    size_t size = 0;
+
+    uint8_t* data() { return storage.data() + offset; }
+    const uint8_t* data() const { return storage.data() + offset; }
+  };
+
+  // num_threads = 0 uses all cores (capped at the number of frames). The
+  // frame-parallel queue is widened to at least the worker count, so every
+  // worker can have a frame in flight. Throws std::runtime_error if zstd
+  // support is not compiled in.
+  explicit ZstdDecoder(const std::string& filepath,
+                       size_t num_threads = 0,
+                       size_t block_bytes = DEFAULT_BLOCK_BYTES,
+                       size_t queue_depth = DEFAULT_QUEUE_DEPTH,
+                       size_t headroom = 0);
+  ~ZstdDecoder();
+
+  ZstdDecoder(const ZstdDecoder&) = delete;
+  ZstdDecoder& operator=(const ZstdDecoder&) = delete;
+
+  // Replace block with the next decompressed block (its old storage is
+  // recycled). Returns false at end of stream; rethrows decode errors.
+  bool next(Block& block);
+
+  // Total decompressed size if known from the frame headers, else 0
+  uint64_t content_size() const;
+
+  // Size of the compressed file
+  uint64_t compressed_size() const;
+
+  // Decoder threads actually running (1 unless frame-parallel)
+  size_t num_threads() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace databento
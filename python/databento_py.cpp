@@ -2,12 +2,372 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <databento/arrow.hpp>
+#include <databento/columnar.hpp>
 #include <databento/parser.hpp>
 #include <databento/dbn.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace py = pybind11;
 
+namespace {
+
+// Structured dtype matching the packed MboMsg/TradeMsg layout (reserved
+// bytes left out). itemsize is the file's record size, so the dtype strides
+// over whole records.
+py::dtype mbo_dtype(size_t record_size) {
+  using databento::MboMsg;
+  py::list names;
+  py::list formats;
+  py::list offsets;
+  auto field = [&](const char* name, const char* format, size_t offset) {
+    names.append(name);
+    formats.append(format);
+    offsets.append(offset);
+  };
+  field("ts_event", "<u8", offsetof(MboMsg, ts_event));
+  field("instrument_id", "<u4", offsetof(MboMsg, instrument_id));
+  field("action", "S1", offsetof(MboMsg, action));
+  field("side", "S1", offsetof(MboMsg, side));
+  field("flags", "u1", offsetof(MboMsg, flags));
+  field("depth", "u1", offsetof(MboMsg, depth));
+  field("price", "<i8", offsetof(MboMsg, price));
+  field("size", "<u4", offsetof(MboMsg, size));
+  field("channel_id", "<u4", offsetof(MboMsg, channel_id));
+  field("order_id", "<u8", offsetof(MboMsg, order_id));
+  field("sequence", "<u4", offsetof(MboMsg, sequence));
+  field("ts_in_delta", "u1", offsetof(MboMsg, ts_in_delta));
+  return py::dtype(names, formats, offsets, static_cast<py::ssize_t>(record_size));
+}
+
+// ============================================================================
+// Zero-copy NumPy views
+// ============================================================================
+
+// DbnParser as bound to Python: counts the live exports that read its
+// loaded data (NumPy views, batch iterators, Arrow exports in progress) so
+// that reloading, which frees or unmaps that data, can be refused instead of
+// leaving them dangling
+class PyDbnParser : public databento::DbnParser {
+public:
+  using databento::DbnParser::DbnParser;
+
+  size_t live_exports = 0;
+  bool loading = false; // A load_* is running with the GIL released
+};
+
+// Counts as a live export of the parser, and keeps it alive, for as long as
+// it lives. Only created and destroyed with the GIL held.
+class ParserPin {
+public:
+  explicit ParserPin(py::object parser)
+      : parser_ref_(std::move(parser)), parser_(&parser_ref_.cast<PyDbnParser&>()) {
+    if (parser_->loading) {
+      throw py::buffer_error("Cannot read the parser while another thread is loading it");
+    }
+    ++parser_->live_exports;
+  }
+  ParserPin(ParserPin&& other) noexcept
+      : parser_ref_(std::move(other.parser_ref_)), parser_(std::exchange(other.parser_, nullptr)) {}
+  ~ParserPin() {
+    if (parser_ != nullptr) {
+      --parser_->live_exports;
+    }
+  }
+
+  ParserPin(const ParserPin&) = delete;
+  ParserPin& operator=(const ParserPin&) = delete;
+  ParserPin& operator=(ParserPin&&) = delete;
+
+  PyDbnParser& parser() const { return *parser_; }
+
+private:
+  py::object parser_ref_;
+  PyDbnParser* parser_;
+};
+
+// Reloading frees or unmaps the data exports read, so every load_* binding
+// raises BufferError while any are alive, the way bytearray refuses to
+// resize under an exported buffer
+void check_reload(const PyDbnParser& parser) {
+  if (parser.loading) {
+    throw py::buffer_error("The parser is already being loaded by another thread");
+  }
+  if (parser.live_exports != 0) {
+    throw py::buffer_error("Cannot reload the parser while " + std::to_string(parser.live_exports) +
+                           " NumPy view(s), batch iterator(s) or Arrow export(s) of its "
+                           "records are alive; delete them first");
+  }
+}
+
+// Wraps a load_* call that releases the GIL: no export can be pinned, and
+// no other load started, until it returns
+class LoadScope {
+public:
+  explicit LoadScope(PyDbnParser& parser) : parser_(parser) {
+    check_reload(parser_);
+    parser_.loading = true;
+  }
+  ~LoadScope() { parser_.loading = false; }
+
+  LoadScope(const LoadScope&) = delete;
+  LoadScope& operator=(const LoadScope&) = delete;
+
+private:
+  PyDbnParser& parser_;
+};
+
+// Maps the file on first use by an export; a first load is checked like
+// any other
+void ensure_loaded(PyDbnParser& parser) {
+  if (!parser.data()) {
+    check_reload(parser);
+    parser.load_with_mmap();
+  }
+}
+
+// Read-only array over the parser's records, without copying. The array's
+// base is a ParserPin, which keeps the parser (and so its buffer or mapping)
+// alive and blocks reloads for the array's lifetime.
+py::array mbo_array(py::object self) {
+  auto& parser = self.cast<PyDbnParser&>();
+  if (parser.record_size() < sizeof(databento::MboMsg)) {
+    throw std::runtime_error("Records are smaller than the MBO layout");
+  }
+  ensure_loaded(parser);
+
+  const auto count = static_cast<py::ssize_t>(parser.num_records());
+  const auto stride = static_cast<py::ssize_t>(parser.record_size());
+  py::object guard = py::cast(std::make_unique<ParserPin>(std::move(self)));
+  py::array array(mbo_dtype(parser.record_size()), {count}, {stride},
+                  parser.data() + parser.metadata_offset(), guard);
+  // The mapping is PROT_READ; writes must fail in Python, not fault
+  array.attr("setflags")(py::arg("write") = false);
+  return array;
+}
+
+// ============================================================================
+// Columnar batch iterator
+// ============================================================================
+
+struct ColumnName {
+  const char* name;
+  uint32_t bit;
+};
+
+constexpr ColumnName MBO_COLUMNS[] = {
+  {"ts_event", databento::COL_TS_EVENT},
+  {"instrument_id", databento::COL_INSTRUMENT_ID},
+  {"action", databento::COL_ACTION},
+  {"side", databento::COL_SIDE},
+  {"flags", databento::COL_FLAGS},
+  {"depth", databento::COL_DEPTH},
+  {"price", databento::COL_PRICE},
+  {"size", databento::COL_SIZE},
+  {"channel_id", databento::COL_CHANNEL_ID},
+  {"order_id", databento::COL_ORDER_ID},
+  {"sequence", databento::COL_SEQUENCE},
+  {"ts_in_delta", databento::COL_TS_IN_DELTA},
+};
+
+uint32_t column_mask(const std::optional<std::vector<std::string>>& names) {
+  if (!names) {
+    return databento::COL_ALL;
+  }
+  uint32_t mask = 0;
+  for (const std::string& name : *names) {
+    uint32_t bit = 0;
+    for (const ColumnName& column : MBO_COLUMNS) {
+      if (name == column.name) {
+        bit = column.bit;
+      }
+    }
+    if (bit == 0) {
+      throw py::value_error("Unknown column: " + name);
+    }
+    mask |= bit;
+  }
+  return mask;
+}
+
+template<typename T>
+py::array column_view(const databento::AlignedBuffer<T>& buffer, py::handle base) {
+  // action/side are single ASCII bytes
+  py::dtype dtype = std::is_same_v<T, char> ? py::dtype("S1") : py::dtype::of<T>();
+  return py::array(dtype, {static_cast<py::ssize_t>(buffer.size())},
+                   {static_cast<py::ssize_t>(sizeof(T))}, buffer.data(), base);
+}
+
+// Decodes batch_size records at a time into reused column buffers with the
+// GIL released. Yielded arrays view those buffers, so each batch's arrays
+// are overwritten by the next one; copy what must outlive the step. The
+// iterator pins the parser (yielded arrays keep the iterator alive), so the
+// records cannot be reloaded under a decode and the first batch stays the
+// largest: the buffers never reallocate under a live view. Like a
+// generator, it refuses a next() from another thread while one is decoding.
+class MboBatchIterator {
+public:
+  MboBatchIterator(py::object parser, size_t batch_size, uint32_t columns)
+      : pin_(std::move(parser)),
+        parser_(pin_.parser()),
+        batch_size_(batch_size),
+        columns_(columns) {}
+
+  py::dict next(py::handle self) {
+    // Checked and set with the GIL held, so the decode below (without it)
+    // can't be entered twice into the same buffers and range
+    if (in_progress_) {
+      throw py::value_error("iterator already executing");
+    }
+    StepScope step(in_progress_);
+
+    const size_t total = parser_.num_records();
+    if (next_ >= total) {
+      throw py::stop_iteration();
+    }
+    const size_t count = std::min(batch_size_, total - next_);
+    parser_.advance_mmap_window(next_);
+    {
+      py::gil_scoped_release release;
+      databento::decode_mbo_columns(parser_.get_batch(next_, count), count,
+                                    parser_.record_size(), columns_, batch_);
+    }
+    next_ += count;
+
+    py::dict out;
+    auto emit = [&](uint32_t bit, const char* name, const auto& buffer) {
+      if (columns_ & bit) {
+        out[name] = column_view(buffer, self);
+      }
+    };
+    emit(databento::COL_TS_EVENT, "ts_event", batch_.ts_event);
+    emit(databento::COL_INSTRUMENT_ID, "instrument_id", batch_.instrument_id);
+    emit(databento::COL_ACTION, "action", batch_.action);
+    emit(databento::COL_SIDE, "side", batch_.side);
+    emit(databento::COL_FLAGS, "flags", batch_.flags);
+    emit(databento::COL_DEPTH, "depth", batch_.depth);
+    emit(databento::COL_PRICE, "price", batch_.price);
+    emit(databento::COL_SIZE, "size", batch_.size);
+    emit(databento::COL_CHANNEL_ID, "channel_id", batch_.channel_id);
+    emit(databento::COL_ORDER_ID, "order_id", batch_.order_id);
+    emit(databento::COL_SEQUENCE, "sequence", batch_.sequence);
+    emit(databento::COL_TS_IN_DELTA, "ts_in_delta", batch_.ts_in_delta);
+    return out;
+  }
+
+private:
+  class StepScope {
+  public:
+    explicit StepScope(bool& flag) : flag_(flag) { flag_ = true; }
+    ~StepScope() { flag_ = false; }
+
+    StepScope(const StepScope&) = delete;
+    StepScope& operator=(const StepScope&) = delete;
+
+  private:
+    bool& flag_;
+  };
+
+  ParserPin pin_;
+  databento::DbnParser& parser_;
+  size_t batch_size_;
+  uint32_t columns_;
+  size_t next_ = 0;
+  bool in_progress_ = false;
+  databento::MboColumns batch_;
+};
+
+// ============================================================================
+// Arrow PyCapsule interface
+// ============================================================================
+
+void release_schema_capsule(PyObject* capsule) {
+  auto* schema = static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsule, "arrow_schema"));
+  if (schema->release != nullptr) {
+    schema->release(schema);
+  }
+  delete schema;
+}
+
+void release_array_capsule(PyObject* capsule) {
+  auto* array = static_cast<ArrowArray*>(PyCapsule_GetPointer(capsule, "arrow_array"));
+  if (array->release != nullptr) {
+    array->release(array);
+  }
+  delete array;
+}
+
+// A record range exported to Arrow consumers (pyarrow, polars, DuckDB)
+// through __arrow_c_array__. Every export decodes the range afresh into
+// buffers owned by the returned capsules, so exports are independent and
+// only block reloads while they are being decoded.
+class ArrowMboBatch {
+public:
+  ArrowMboBatch(py::object parser, size_t start, size_t count, uint32_t columns)
+      : parser_ref_(std::move(parser)),
+        parser_(parser_ref_.cast<PyDbnParser&>()),
+        start_(start),
+        count_(count),
+        columns_(columns) {}
+
+  py::capsule schema() const {
+    auto schema = std::make_unique<ArrowSchema>();
+    databento::export_mbo_schema(columns_, schema.get());
+    return py::capsule(schema.release(), "arrow_schema", &release_schema_capsule);
+  }
+
+  // requested_schema is ignored, as the protocol allows. The decode reads
+  // the parser with the GIL released, so it is pinned against reloads for
+  // the duration; the range is rechecked since a reload may have shrunk it.
+  py::tuple array(const py::object& /*requested_schema*/) const {
+    ParserPin pin(parser_ref_);
+    if (start_ + count_ > parser_.num_records()) {
+      throw py::index_error("Batch range is beyond the last record of the reloaded file");
+    }
+    auto schema = std::make_unique<ArrowSchema>();
+    auto array = std::make_unique<ArrowArray>();
+    {
+      py::gil_scoped_release release;
+      databento::export_mbo_batch(parser_, start_, count_, columns_, schema.get(), array.get());
+    }
+    py::capsule schema_capsule(schema.release(), "arrow_schema", &release_schema_capsule);
+    py::capsule array_capsule(array.release(), "arrow_array", &release_array_capsule);
+    return py::make_tuple(schema_capsule, array_capsule);
+  }
+
+  size_t size() const { return count_; }
+
+private:
+  py::object parser_ref_; // Keeps the parser and its mapping alive
+  databento::DbnParser& parser_;
+  size_t start_;
+  size_t count_;
+  uint32_t columns_;
+};
+
+ArrowMboBatch make_arrow_batch(py::object self, size_t start, std::optional<size_t> count,
+                               const std::optional<std::vector<std::string>>& columns) {
+  auto& parser = self.cast<PyDbnParser&>();
+  if (parser.record_size() < sizeof(databento::MboMsg)) {
+    throw std::runtime_error("Records are smaller than the MBO layout");
+  }
+  ensure_loaded(parser);
+  const size_t total = parser.num_records();
+  if (start > total) {
+    throw py::index_error("start is beyond the last record");
+  }
+  const size_t n = count ? std::min(*count, total - start) : total - start;
+  return ArrowMboBatch(std::move(self), start, n, column_mask(columns));
+}
+
+} // namespace
+
 PYBIND11_MODULE(databento_cpp, m) {
   m.doc() = "Ultra-fast databento parser (200M+ records/sec) - Alternative to official databento-cpp";
 
@@ -30,6 +390,17 @@ PYBIND11_MODULE(databento_cpp, m) {
     .value("None_", databento::Side::None)
     .export_values();
 
+  py::enum_<databento::HugePages>(m, "HugePages")
+    .value("Off", databento::HugePages::Off)
+    .value("Transparent", databento::HugePages::Transparent)
+    .value("HugeTlb", databento::HugePages::HugeTlb);
+
+  py::enum_<databento::PageBacking>(m, "PageBacking")
+    .value("Heap", databento::PageBacking::Heap)
+    .value("Small", databento::PageBacking::Small)
+    .value("Transparent", databento::PageBacking::Transparent)
+    .value("HugeTlb", databento::PageBacking::HugeTlb);
+
   // ============================================================================
   // MboMsg struct
   // ============================================================================
@@ -78,11 +449,29 @@ PYBIND11_MODULE(databento_cpp, m) {
   // ParseStats struct
   // ============================================================================
   
+  py::class_<databento::PerfSample>(m, "PerfSample")
+    .def_readonly("cycles", &databento::PerfSample::cycles)
+    .def_readonly("instructions", &databento::PerfSample::instructions)
+    .def_readonly("llc_misses", &databento::PerfSample::llc_misses)
+    .def_readonly("dtlb_misses", &databento::PerfSample::dtlb_misses)
+    .def_readonly("branch_misses", &databento::PerfSample::branch_misses)
+    .def_property_readonly("valid", &databento::PerfSample::valid)
+    .def_property_readonly("ipc", &databento::PerfSample::ipc);
+
   py::class_<databento::ParseStats>(m, "ParseStats")
     .def_readonly("total_records", &databento::ParseStats::total_records)
+    .def_readonly("total_bytes", &databento::ParseStats::total_bytes)
     .def_readonly("elapsed_seconds", &databento::ParseStats::elapsed_seconds)
+    .def_readonly("load_seconds", &databento::ParseStats::load_seconds)
+    .def_readonly("parse_seconds", &databento::ParseStats::parse_seconds)
     .def_readonly("records_per_second", &databento::ParseStats::records_per_second)
     .def_readonly("throughput_gbps", &databento::ParseStats::throughput_gbps)
+    .def_readonly("page_backing", &databento::ParseStats::page_backing)
+    .def_readonly("huge_page_bytes", &databento::ParseStats::huge_page_bytes)
+    .def_readonly("mmap_window_bytes", &databento::ParseStats::mmap_window_bytes)
+    .def_readonly("resident_bytes", &databento::ParseStats::resident_bytes)
+    .def_readonly("load_counters", &databento::ParseStats::load_counters)
+    .def_readonly("parse_counters", &databento::ParseStats::parse_counters)
     .def("print", &databento::ParseStats::print)
     .def("__repr__", [](const databento::ParseStats& s) {
       return "<ParseStats records=" + std::to_string(s.total_records) +
@@ -90,39 +479,126 @@ PYBIND11_MODULE(databento_cpp, m) {
              " throughput=" + std::to_string(s.throughput_gbps) + " GB/s>";
     });
 
+  // ============================================================================
+  // Columnar batch iterator
+  // ============================================================================
+
+  py::class_<MboBatchIterator>(m, "MboBatchIterator")
+    .def("__iter__", [](py::object self) { return self; })
+    .def("__next__", [](py::object self) {
+      return self.cast<MboBatchIterator&>().next(self);
+    });
+
+  // ============================================================================
+  // Arrow export
+  // ============================================================================
+
+  py::class_<ArrowMboBatch>(m, "ArrowMboBatch")
+    .def("__arrow_c_schema__", &ArrowMboBatch::schema)
+    .def("__arrow_c_array__", &ArrowMboBatch::array, py::arg("requested_schema") = py::none())
+    .def("__len__", &ArrowMboBatch::size);
+
   // ============================================================================
   // DbnParser class
   // ============================================================================
   
-  py::class_<databento::DbnParser>(m, "DbnParser")
+  // Base object of to_numpy() arrays; not constructible from Python
+  py::class_<ParserPin>(m, "_ParserPin");
+
+  py::class_<PyDbnParser>(m, "DbnParser")
     .def(py::init<const std::string&>(), py::arg("filepath"),
          "Create parser for DBN file")
-    .def("load_into_memory", &databento::DbnParser::load_into_memory,
-         "Load entire file into memory (zero-copy)")
-    .def("parse_mbo", &databento::DbnParser::parse_mbo, py::arg("callback"),
-         "Parse MBO records with callback function")
-    .def("parse_trade", &databento::DbnParser::parse_trade, py::arg("callback"),
-         "Parse Trade records with callback function")
+    .def("load_into_memory", [](PyDbnParser& parser) {
+      check_reload(parser);
+      parser.load_into_memory();
+    }, "Load entire file into memory (zero-copy)")
+    .def("load_parallel", [](PyDbnParser& parser, size_t num_threads, size_t chunk_bytes) {
+      LoadScope scope(parser);
+      py::gil_scoped_release release;
+      parser.load_parallel(num_threads, chunk_bytes);
+    }, py::arg("num_threads") = 0,
+       py::arg("chunk_bytes") = databento::DbnParser::DEFAULT_PARALLEL_CHUNK_BYTES,
+       "Load with parallel positional reads into one buffer")
+    .def("load_numa", [](PyDbnParser& parser, size_t num_threads, bool interleave) {
+      LoadScope scope(parser);
+      py::gil_scoped_release release;
+      parser.load_numa(num_threads, interleave);
+    }, py::arg("num_threads") = 0, py::arg("interleave") = false,
+       "Load with pinned workers that first-touch the ranges they will parse")
+    .def("set_huge_pages", &databento::DbnParser::set_huge_pages, py::arg("mode"),
+         "Back the next load with huge pages (HugePages.Transparent / HugeTlb)")
+    .def_property_readonly("page_backing", &databento::DbnParser::page_backing,
+         "Page backing the loaded data got")
+    .def("huge_page_bytes", &databento::DbnParser::huge_page_bytes,
+         "Bytes of loaded data currently on huge pages")
+    .def("load_with_mmap", [](PyDbnParser& parser) {
+      check_reload(parser);
+      parser.load_with_mmap();
+    }, "Memory-map the file (zero-copy)")
+    .def("set_mmap_window", &databento::DbnParser::set_mmap_window, py::arg("window_bytes"),
+         "Bound mmap scans to a sliding window of this many bytes (0 = whole file)")
+    .def("resident_bytes", &databento::DbnParser::resident_bytes,
+         "Bytes of loaded data currently in memory")
+    // Lambdas, not overload_cast: the inlined template overloads make the
+    // member pointers non-deducible
+    .def("parse_mbo", [](PyDbnParser& parser, databento::MboCallback callback) {
+      parser.parse_mbo(callback);
+    }, py::arg("callback"), "Parse MBO records with callback function")
+    .def("parse_trade", [](PyDbnParser& parser, databento::TradeCallback callback) {
+      parser.parse_trade(callback);
+    }, py::arg("callback"), "Parse Trade records with callback function")
+    .def("lower_bound_time", &databento::DbnParser::lower_bound_time, py::arg("ts"),
+         "Index of the first record with ts_event >= ts")
+    .def("parse_mbo_range", [](PyDbnParser& parser, uint64_t start_ts, uint64_t end_ts,
+                                databento::MboCallback callback) {
+      parser.parse_mbo_range(start_ts, end_ts, callback);
+    }, py::arg("start_ts"), py::arg("end_ts"), py::arg("callback"),
+       "Parse MBO records with start_ts <= ts_event < end_ts")
+    .def("parse_trade_range", [](PyDbnParser& parser, uint64_t start_ts, uint64_t end_ts,
+                                  databento::TradeCallback callback) {
+      parser.parse_trade_range(start_ts, end_ts, callback);
+    }, py::arg("start_ts"), py::arg("end_ts"), py::arg("callback"),
+       "Parse Trade records with start_ts <= ts_event < end_ts")
+    .def("build_time_index", [](PyDbnParser& parser, size_t block_records) {
+      parser.build_time_index(block_records);
+    }, py::arg("block_records") = databento::TimeIndex::DEFAULT_BLOCK_RECORDS,
+       "Build the sparse min/max time index (needed for unsorted files)")
+    .def("parse_mbo_instrument", [](PyDbnParser& parser, uint32_t instrument_id,
+                                     databento::MboCallback callback) {
+      parser.parse_mbo_instrument(instrument_id, callback);
+    }, py::arg("instrument_id"), py::arg("callback"),
+       "Parse only one instrument's MBO records via the sidecar index")
+    .def("parse_trade_instrument", [](PyDbnParser& parser, uint32_t instrument_id,
+                                       databento::TradeCallback callback) {
+      parser.parse_trade_instrument(instrument_id, callback);
+    }, py::arg("instrument_id"), py::arg("callback"),
+       "Parse only one instrument's Trade records via the sidecar index")
+    .def("instruments", [](PyDbnParser& parser) {
+      return parser.instrument_index().instruments();
+    }, "Instrument ids present in the file (builds the index if needed)")
     .def("num_records", &databento::DbnParser::num_records,
          "Get number of records in file")
     .def("record_size", &databento::DbnParser::record_size,
          "Get size of each record in bytes")
     .def("size", &databento::DbnParser::size,
          "Get total file size in bytes")
-    .def("get_record_mbo", [](databento::DbnParser& parser, size_t idx) {
+    .def("get_record_mbo", [](PyDbnParser& parser, size_t idx) {
       if (!parser.data()) {
+        check_reload(parser);
         parser.load_into_memory();
       }
       return databento::parse_mbo(parser.get_record(idx));
     }, py::arg("index"), "Get MBO record at index")
-    .def("get_record_trade", [](databento::DbnParser& parser, size_t idx) {
+    .def("get_record_trade", [](PyDbnParser& parser, size_t idx) {
       if (!parser.data()) {
+        check_reload(parser);
         parser.load_into_memory();
       }
       return databento::parse_trade(parser.get_record(idx));
     }, py::arg("index"), "Get Trade record at index")
-    .def("get_all_mbo", [](databento::DbnParser& parser) {
+    .def("get_all_mbo", [](PyDbnParser& parser) {
       if (!parser.data()) {
+        check_reload(parser);
         parser.load_into_memory();
       }
       
@@ -134,8 +610,34 @@ PYBIND11_MODULE(databento_cpp, m) {
       }
       return records;
     }, "Load all MBO records into Python list (fast!)")
+    .def("iter_batches", [](py::object self, size_t batch_size,
+                            const std::optional<std::vector<std::string>>& columns) {
+      if (batch_size == 0) {
+        throw py::value_error("batch_size must be positive");
+      }
+      auto& parser = self.cast<PyDbnParser&>();
+      if (parser.record_size() < sizeof(databento::MboMsg)) {
+        throw std::runtime_error("Records are smaller than the MBO layout");
+      }
+      ensure_loaded(parser);
+      return MboBatchIterator(self, batch_size, column_mask(columns));
+    }, py::arg("batch_size") = 65536, py::arg("columns") = py::none(),
+       "Iterate over dicts of NumPy MBO/Trade columns, decoded with the GIL "
+       "released. Arrays are reused between batches; load_* raises "
+       "BufferError while the iterator or its arrays are alive.")
+    .def("arrow_batch", &make_arrow_batch,
+         py::arg("start") = 0, py::arg("count") = py::none(), py::arg("columns") = py::none(),
+         "Record range as an Arrow-exportable batch (e.g. pyarrow.record_batch(...))")
+    .def("__arrow_c_array__", [](py::object self, const py::object& requested_schema) {
+      return make_arrow_batch(std::move(self), 0, std::nullopt, std::nullopt).array(requested_schema);
+    }, py::arg("requested_schema") = py::none(),
+       "Whole file as one Arrow struct array (all MBO columns)")
+    .def("to_numpy", &mbo_array,
+         "Zero-copy read-only NumPy structured array of the MBO/Trade records "
+         "(memory-maps the file if not loaded). load_* raises BufferError "
+         "while the array or any view of it is alive.")
     .def("__len__", &databento::DbnParser::num_records)
-    .def("__repr__", [](const databento::DbnParser& p) {
+    .def("__repr__", [](const PyDbnParser& p) {
       return "<DbnParser records=" + std::to_string(p.num_records()) +
              " size=" + std::to_string(p.size()) + " bytes>";
     });
@@ -154,15 +656,21 @@ PYBIND11_MODULE(databento_cpp, m) {
   // ============================================================================
   
   m.def("parse_file_mbo", 
-    [](const std::string& filepath, py::function callback) {
+    [](const std::string& filepath, py::function callback, bool hw_counters,
+       databento::HugePages huge_pages, size_t mmap_window) {
       auto cpp_callback = [&callback](const databento::MboMsg& msg) {
         callback(msg);
       };
-      return databento::parse_file_mbo(filepath, cpp_callback);
+      return databento::parse_file_mbo(filepath, cpp_callback, hw_counters, huge_pages,
+                                       mmap_window);
     },
     py::arg("filepath"),
     py::arg("callback"),
-    "Parse MBO file with callback function");
+    py::arg("hw_counters") = false,
+    py::arg("huge_pages") = databento::HugePages::Off,
+    py::arg("mmap_window") = 0,
+    "Parse MBO file with callback function (hw_counters: sample perf counters; "
+    "mmap_window: map with a sliding window of this many bytes)");
 
   m.def("parse_file_mbo_fast", 
     [](const std::string& filepath) {
@@ -181,6 +689,13 @@ PYBIND11_MODULE(databento_cpp, m) {
     py::arg("filepath"),
     "Fast parse: Load all MBO records into list (recommended!)");
 
+  m.def("load_mbo_array",
+    [](const std::string& filepath) {
+      return mbo_array(py::cast(std::make_unique<PyDbnParser>(filepath)));
+    },
+    py::arg("filepath"),
+    "Memory-map a file as a zero-copy NumPy structured array of MBO records");
+
   // ============================================================================
   // Version info
   // ============================================================================
@@ -25,7 +25,7 @@ here = os.path.abspath(os.path.dirname(__file__))
 ext_modules = [
     Pybind11Extension(
         "databento_cpp",
-        ["python/databento_py.cpp", "src/parser.cpp"],
+        ["python/databento_py.cpp", "src/parser.cpp", "src/stream.cpp", "src/io.cpp", "src/zstd.cpp", "src/columnar.cpp", "src/filter.cpp", "src/time_index.cpp", "src/instrument_index.cpp", "src/book.cpp", "src/bars.cpp", "src/merge.cpp", "src/arrow.cpp", "src/synthetic.cpp", "src/perf.cpp", "src/buffer.cpp", "src/numa.cpp"],
         include_dirs=[os.path.join(here, "include")],
         extra_compile_args=["-O3", "-march=native", "-std=c++20"],
         cxx_std=20,
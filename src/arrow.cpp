@@ -0,0 +1,155 @@
+#include "databento/arrow.hpp"
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace databento {
+
+namespace {
+
+// ============================================================================
+// Column Table
+// ============================================================================
+
+struct ColumnSpec {
+  uint32_t bit;
+  const char* name;
+  const char* format;
+  const void* (*data)(const MboColumns&);
+};
+
+// Record order; formats per the C data interface format strings
+const ColumnSpec COLUMN_SPECS[] = {
+  {COL_TS_EVENT, "ts_event", "tsn:UTC", [](const MboColumns& c) -> const void* { return c.ts_event.data(); }},
+  {COL_INSTRUMENT_ID, "instrument_id", "I", [](const MboColumns& c) -> const void* { return c.instrument_id.data(); }},
+  {COL_ACTION, "action", "w:1", [](const MboColumns& c) -> const void* { return c.action.data(); }},
+  {COL_SIDE, "side", "w:1", [](const MboColumns& c) -> const void* { return c.side.data(); }},
+  {COL_FLAGS, "flags", "C", [](const MboColumns& c) -> const void* { return c.flags.data(); }},
+  {COL_DEPTH, "depth", "C", [](const MboColumns& c) -> const void* { return c.depth.data(); }},
+  {COL_PRICE, "price", "l", [](const MboColumns& c) -> const void* { return c.price.data(); }},
+  {COL_SIZE, "size", "I", [](const MboColumns& c) -> const void* { return c.size.data(); }},
+  {COL_CHANNEL_ID, "channel_id", "I", [](const MboColumns& c) -> const void* { return c.channel_id.data(); }},
+  {COL_ORDER_ID, "order_id", "L", [](const MboColumns& c) -> const void* { return c.order_id.data(); }},
+  {COL_SEQUENCE, "sequence", "I", [](const MboColumns& c) -> const void* { return c.sequence.data(); }},
+  {COL_TS_IN_DELTA, "ts_in_delta", "C", [](const MboColumns& c) -> const void* { return c.ts_in_delta.data(); }},
+};
+
+// ============================================================================
+// Schema Export
+// ============================================================================
+
+// Child schemas live in the parent's holder; format and name strings are
+// static, so a moved-out child has nothing of its own to free
+struct SchemaHolder {
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema*> child_ptrs;
+};
+
+void release_child_schema(ArrowSchema* schema) {
+  schema->release = nullptr;
+}
+
+void release_schema(ArrowSchema* schema) {
+  auto* holder = static_cast<SchemaHolder*>(schema->private_data);
+  for (ArrowSchema* child : holder->child_ptrs) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+  }
+  delete holder;
+  schema->release = nullptr;
+}
+
+// ============================================================================
+// Array Export
+// ============================================================================
+
+// Every child shares ownership of the column buffers, so children can be
+// moved out and released independently of the parent
+struct ChildHolder {
+  std::shared_ptr<const MboColumns> columns;
+  const void* buffers[2];
+};
+
+struct ArrayHolder {
+  std::shared_ptr<const MboColumns> columns;
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_ptrs;
+  const void* buffers[1] = {nullptr};
+};
+
+void release_child_array(ArrowArray* array) {
+  delete static_cast<ChildHolder*>(array->private_data);
+  array->release = nullptr;
+}
+
+void release_array(ArrowArray* array) {
+  auto* holder = static_cast<ArrayHolder*>(array->private_data);
+  for (ArrowArray* child : holder->child_ptrs) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+  }
+  delete holder;
+  array->release = nullptr;
+}
+
+} // namespace
+
+void export_mbo_schema(uint32_t columns, ArrowSchema* out) {
+  auto holder = std::make_unique<SchemaHolder>();
+  holder->children.reserve(std::size(COLUMN_SPECS));
+  for (const ColumnSpec& spec : COLUMN_SPECS) {
+    if (columns & spec.bit) {
+      holder->children.push_back(
+          {spec.format, spec.name, nullptr, 0, 0, nullptr, nullptr, &release_child_schema, nullptr});
+    }
+  }
+  for (ArrowSchema& child : holder->children) {
+    holder->child_ptrs.push_back(&child);
+  }
+
+  *out = {"+s", "", nullptr, 0, static_cast<int64_t>(holder->child_ptrs.size()),
+          holder->child_ptrs.data(), nullptr, &release_schema, nullptr};
+  out->private_data = holder.release();
+}
+
+void export_mbo_columns(MboColumns&& columns, ArrowArray* out) {
+  auto shared = std::make_shared<const MboColumns>(std::move(columns));
+  const auto length = static_cast<int64_t>(shared->count);
+
+  auto holder = std::make_unique<ArrayHolder>();
+  holder->columns = shared;
+  holder->children.reserve(std::size(COLUMN_SPECS));
+  for (const ColumnSpec& spec : COLUMN_SPECS) {
+    if (shared->columns & spec.bit) {
+      auto* child = new ChildHolder{shared, {nullptr, spec.data(*shared)}};
+      holder->children.push_back(
+          {length, 0, 0, 2, 0, child->buffers, nullptr, nullptr, &release_child_array, child});
+    }
+  }
+  for (ArrowArray& child : holder->children) {
+    holder->child_ptrs.push_back(&child);
+  }
+
+  *out = {length, 0, 0, 1, static_cast<int64_t>(holder->child_ptrs.size()),
+          holder->buffers, holder->child_ptrs.data(), nullptr, &release_array, nullptr};
+  out->private_data = holder.release();
+}
+
+void export_mbo_batch(const DbnParser& parser, size_t start, size_t count, uint32_t columns,
+                      ArrowSchema* schema, ArrowArray* array) {
+  if (!parser.data()) {
+    throw std::runtime_error("Parser must be loaded before exporting batches");
+  }
+  if (parser.record_size() < sizeof(MboMsg)) {
+    throw std::runtime_error("Records are smaller than the MBO layout");
+  }
+  MboColumns batch;
+  decode_mbo_columns(parser.get_batch(start, count), count, parser.record_size(), columns, batch);
+  export_mbo_schema(columns, schema);
+  export_mbo_columns(std::move(batch), array);
+}
+
+} // namespace databento
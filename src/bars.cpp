@@ -0,0 +1,177 @@
+#include "databento/bars.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace databento {
+
+std::optional<RType> ohlcv_rtype(uint64_t interval_ns) {
+  switch (interval_ns) {
+    case BAR_1S: return RType::Ohlcv1S;
+    case BAR_1M: return RType::Ohlcv1M;
+    case BAR_1H: return RType::Ohlcv1H;
+    case BAR_1D: return RType::Ohlcv1D;
+    default: return std::nullopt;
+  }
+}
+
+void OhlcvBars::clear() {
+  ts_event.clear();
+  instrument_id.clear();
+  open.clear();
+  high.clear();
+  low.clear();
+  close.clear();
+  volume.clear();
+}
+
+// ============================================================================
+// BarBuilder Implementation
+// ============================================================================
+
+BarBuilder::BarBuilder(std::vector<uint64_t> intervals_ns)
+    : intervals_(std::move(intervals_ns)),
+      output_(intervals_.size()),
+      bucket_start_(intervals_.size(), 0) {
+  if (intervals_.empty()) {
+    throw std::invalid_argument("BarBuilder needs at least one interval");
+  }
+  for (size_t k = 0; k < intervals_.size(); ++k) {
+    if (intervals_[k] == 0) {
+      throw std::invalid_argument("Bar interval must be positive");
+    }
+    output_[k].interval_ns = intervals_[k];
+  }
+}
+
+BarBuilder::Bar* BarBuilder::bars_for(uint32_t instrument_id) {
+  // Trades come in runs per instrument; skip the hash lookup for those
+  if (last_slot_ == SIZE_MAX || last_id_ != instrument_id) {
+    auto [it, inserted] = slots_.try_emplace(instrument_id, slot_ids_.size());
+    if (inserted) {
+      slot_ids_.push_back(instrument_id);
+      open_bars_.resize(open_bars_.size() + intervals_.size(), Bar{0, 0, 0, 0, 0, 0, false});
+    }
+    last_id_ = instrument_id;
+    last_slot_ = it->second;
+  }
+  return open_bars_.data() + last_slot_ * intervals_.size();
+}
+
+void BarBuilder::emit(size_t k, uint32_t instrument_id, const Bar& bar) {
+  OhlcvBars& out = output_[k];
+  out.ts_event.push_back(bar.bucket);
+  out.instrument_id.push_back(instrument_id);
+  out.open.push_back(bar.open);
+  out.high.push_back(bar.high);
+  out.low.push_back(bar.low);
+  out.close.push_back(bar.close);
+  out.volume.push_back(bar.volume);
+}
+
+void BarBuilder::update(Bar* bars, uint32_t instrument_id, const uint64_t* buckets,
+                        size_t stride, int64_t price, uint32_t size) {
+  for (size_t k = 0; k < intervals_.size(); ++k) {
+    Bar& bar = bars[k];
+    const uint64_t bucket = buckets[k * stride];
+    if (!bar.active || bucket > bar.bucket) {
+      if (bar.active) {
+        emit(k, instrument_id, bar);
+      }
+      bar = {bucket, price, price, price, price, size, true};
+    } else {
+      bar.high = std::max(bar.high, price);
+      bar.low = std::min(bar.low, price);
+      bar.close = price;
+      bar.volume += size;
+    }
+  }
+}
+
+void BarBuilder::add_trade(uint64_t ts_event, uint32_t instrument_id, int64_t price,
+                           uint32_t size) {
+  uint64_t buckets[16];
+  std::vector<uint64_t> spill;
+  uint64_t* out = buckets;
+  if (intervals_.size() > 16) {
+    spill.resize(intervals_.size());
+    out = spill.data();
+  }
+  for (size_t k = 0; k < intervals_.size(); ++k) {
+    out[k] = ts_event - ts_event % intervals_[k];
+  }
+  update(bars_for(instrument_id), instrument_id, out, 1, price, size);
+}
+
+void BarBuilder::consume(const uint8_t* records, size_t count, size_t rec_size,
+                         BarSource source) {
+  for (size_t start = 0; start < count; start += BATCH_RECORDS) {
+    const size_t n = std::min(BATCH_RECORDS, count - start);
+    const uint32_t wanted = COL_TS_EVENT | COL_INSTRUMENT_ID | COL_PRICE | COL_SIZE |
+                            (source == BarSource::Trades ? 0 : COL_ACTION);
+    decode_mbo_columns(records + start * rec_size, n, rec_size, wanted, columns_);
+
+    // Bucket starts per interval. Timestamps mostly advance within the
+    // current bucket, so the unsigned range test replaces a division
+    buckets_.resize(intervals_.size() * n);
+    const uint64_t* ts = columns_.ts_event.data();
+    for (size_t k = 0; k < intervals_.size(); ++k) {
+      const uint64_t interval = intervals_[k];
+      uint64_t current = bucket_start_[k];
+      uint64_t* out = buckets_.data() + k * n;
+      for (size_t i = 0; i < n; ++i) {
+        if (ts[i] - current >= interval) {
+          current = ts[i] - ts[i] % interval;
+        }
+        out[i] = current;
+      }
+      bucket_start_[k] = current;
+    }
+
+    const char* action = source == BarSource::Trades ? nullptr : columns_.action.data();
+    for (size_t i = 0; i < n; ++i) {
+      if (action != nullptr) {
+        const bool trade = action[i] == static_cast<char>(Action::Trade);
+        const bool fill = action[i] == static_cast<char>(Action::Fill);
+        if (!trade && !(fill && source == BarSource::MboTradesAndFills)) {
+          continue;
+        }
+      }
+      const uint32_t id = columns_.instrument_id[i];
+      update(bars_for(id), id, buckets_.data() + i, n, columns_.price[i], columns_.size[i]);
+    }
+  }
+}
+
+void BarBuilder::consume(DbnParser& parser, BarSource source) {
+  if (parser.schema() != RType::Mbo && parser.schema() != RType::Trade) {
+    throw std::invalid_argument("Bars need an MBO or trades file");
+  }
+  if (source == BarSource::Trades && parser.schema() == RType::Mbo) {
+    // Every MBO add, cancel and modify would be counted as a trade
+    throw std::invalid_argument("MBO files need BarSource::MboTrades or MboTradesAndFills");
+  }
+  if (!parser.data()) {
+    parser.load_with_mmap();
+  }
+  const size_t total = parser.num_records();
+  const size_t step = parser.mmap_window_step();
+  for (size_t start = 0; start < total; start += step) {
+    const size_t n = std::min(step, total - start);
+    parser.advance_mmap_window(start);
+    consume(parser.get_batch(start, n), n, parser.record_size(), source);
+  }
+}
+
+void BarBuilder::flush() {
+  for (size_t slot = 0; slot < slot_ids_.size(); ++slot) {
+    Bar* bars = open_bars_.data() + slot * intervals_.size();
+    for (size_t k = 0; k < intervals_.size(); ++k) {
+      if (bars[k].active) {
+        emit(k, slot_ids_[slot], bars[k]);
+        bars[k].active = false;
+      }
+    }
+  }
+}
+
+} // namespace databento
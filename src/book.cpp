@@ -0,0 +1,291 @@
+#include "databento/book.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace databento {
+
+// ============================================================================
+// OrderIdMap Implementation
+// ============================================================================
+
+OrderIdMap::OrderIdMap(size_t expected)
+    : slots_(std::bit_ceil(std::max<size_t>(expected * 2, 16)), Slot{0, NONE}),
+      mask_(slots_.size() - 1),
+      size_(0) {}
+
+void OrderIdMap::insert(uint64_t order_id, uint32_t value) {
+  // Keep the load factor at or below 1/2
+  if ((size_ + 1) * 2 > slots_.size()) {
+    grow();
+  }
+  size_t i = hash(order_id) & mask_;
+  while (slots_[i].value != NONE) {
+    i = (i + 1) & mask_;
+  }
+  slots_[i] = {order_id, value};
+  ++size_;
+}
+
+void OrderIdMap::erase(uint64_t order_id) {
+  size_t i = hash(order_id) & mask_;
+  for (;; i = (i + 1) & mask_) {
+    if (slots_[i].value == NONE) {
+      return;
+    }
+    if (slots_[i].key == order_id) {
+      break;
+    }
+  }
+
+  // Shift later members of the probe run back into the hole, unless their
+  // home slot lies cyclically after the hole
+  for (size_t j = (i + 1) & mask_; slots_[j].value != NONE; j = (j + 1) & mask_) {
+    const size_t home = hash(slots_[j].key) & mask_;
+    const bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+    if (!stays) {
+      slots_[i] = slots_[j];
+      i = j;
+    }
+  }
+  slots_[i].value = NONE;
+  --size_;
+}
+
+void OrderIdMap::clear() {
+  std::fill(slots_.begin(), slots_.end(), Slot{0, NONE});
+  size_ = 0;
+}
+
+void OrderIdMap::grow() {
+  std::vector<Slot> old(slots_.size() * 2, Slot{0, NONE});
+  old.swap(slots_);
+  mask_ = slots_.size() - 1;
+  for (const Slot& slot : old) {
+    if (slot.value != NONE) {
+      size_t i = hash(slot.key) & mask_;
+      while (slots_[i].value != NONE) {
+        i = (i + 1) & mask_;
+      }
+      slots_[i] = slot;
+    }
+  }
+}
+
+// ============================================================================
+// OrderBook Implementation
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t NIL = OrderIdMap::NONE;
+
+// Levels to walk down from the top before switching to binary search
+constexpr size_t LINEAR_LEVELS = 8;
+
+} // namespace
+
+OrderBook::OrderBook(size_t expected_orders) : orders_(expected_orders) {
+  pool_.reserve(expected_orders);
+}
+
+size_t OrderBook::find_level(const std::vector<Level>& levels, bool bid, int64_t price) {
+  // Levels are sorted worst to best; find the first one not worse than price
+  auto worse = [bid](int64_t a, int64_t b) { return bid ? a < b : a > b; };
+
+  // Most updates land near the top of book, at the back
+  size_t i = levels.size();
+  for (size_t steps = 0; i > 0 && steps < LINEAR_LEVELS; --i, ++steps) {
+    if (!worse(price, levels[i - 1].price)) {
+      return levels[i - 1].price == price ? i - 1 : i;
+    }
+  }
+  auto it = std::lower_bound(levels.begin(), levels.begin() + i, price,
+                             [&](const Level& level, int64_t p) { return worse(level.price, p); });
+  return static_cast<size_t>(it - levels.begin());
+}
+
+PriceLevel OrderBook::view(const std::vector<Level>& levels, size_t depth) {
+  if (depth >= levels.size()) {
+    return {};
+  }
+  const Level& level = levels[levels.size() - 1 - depth];
+  return {level.price, level.size, level.count};
+}
+
+void OrderBook::enqueue(Level& level, uint32_t node) {
+  Order& order = pool_[node];
+  order.prev = level.tail;
+  order.next = NIL;
+  if (level.tail != NIL) {
+    pool_[level.tail].next = node;
+  } else {
+    level.head = node;
+  }
+  level.tail = node;
+  level.size += order.size;
+  ++level.count;
+}
+
+void OrderBook::unlink(Level& level, uint32_t node) {
+  Order& order = pool_[node];
+  if (order.prev != NIL) {
+    pool_[order.prev].next = order.next;
+  } else {
+    level.head = order.next;
+  }
+  if (order.next != NIL) {
+    pool_[order.next].prev = order.prev;
+  } else {
+    level.tail = order.prev;
+  }
+  level.size -= order.size;
+  --level.count;
+}
+
+void OrderBook::add(uint64_t order_id, bool bid, int64_t price, uint32_t size) {
+  uint32_t node;
+  if (!free_.empty()) {
+    node = free_.back();
+    free_.pop_back();
+  } else {
+    node = static_cast<uint32_t>(pool_.size());
+    pool_.emplace_back();
+  }
+  pool_[node] = {order_id, price, size, NIL, NIL, bid};
+
+  std::vector<Level>& levels = side(bid);
+  const size_t pos = find_level(levels, bid, price);
+  if (pos == levels.size() || levels[pos].price != price) {
+    levels.insert(levels.begin() + pos, Level{price, 0, 0, NIL, NIL});
+  }
+  enqueue(levels[pos], node);
+  orders_.insert(order_id, node);
+}
+
+void OrderBook::remove(uint32_t node) {
+  const Order& order = pool_[node];
+  std::vector<Level>& levels = side(order.bid);
+  const size_t pos = find_level(levels, order.bid, order.price);
+  unlink(levels[pos], node);
+  if (levels[pos].count == 0) {
+    levels.erase(levels.begin() + pos);
+  }
+  orders_.erase(order.order_id);
+  free_.push_back(node);
+}
+
+void OrderBook::apply(const MboMsg& msg) {
+  const bool has_side = msg.side == static_cast<char>(Side::Bid) ||
+                        msg.side == static_cast<char>(Side::Ask);
+  const bool bid = msg.side == static_cast<char>(Side::Bid);
+
+  switch (static_cast<Action>(msg.action)) {
+    case Action::Add:
+    case Action::Modify: {
+      const uint32_t node = orders_.find(msg.order_id);
+      if (node == NIL) {
+        if (has_side && msg.size > 0) {
+          add(msg.order_id, bid, msg.price, msg.size);
+        }
+        return;
+      }
+      Order& order = pool_[node];
+      const bool same_side = !has_side || bid == order.bid;
+      if (msg.size == 0) {
+        remove(node);
+      } else if (order.price != msg.price || !same_side || msg.size > order.size) {
+        // New price or larger size loses queue priority
+        const bool new_bid = has_side ? bid : order.bid;
+        remove(node);
+        add(msg.order_id, new_bid, msg.price, msg.size);
+      } else if (msg.size < order.size) {
+        // Size reductions keep their place in the queue
+        Level& level = side(order.bid)[find_level(side(order.bid), order.bid, order.price)];
+        level.size -= order.size - msg.size;
+        order.size = msg.size;
+      }
+      return;
+    }
+    case Action::Cancel: {
+      const uint32_t node = orders_.find(msg.order_id);
+      if (node == NIL) {
+        return;
+      }
+      Order& order = pool_[node];
+      if (msg.size >= order.size) {
+        remove(node);
+      } else {
+        Level& level = side(order.bid)[find_level(side(order.bid), order.bid, order.price)];
+        level.size -= msg.size;
+        order.size -= msg.size;
+      }
+      return;
+    }
+    case Action::Clear:
+      clear();
+      return;
+    case Action::Trade:
+    case Action::Fill:
+      return;
+  }
+}
+
+void OrderBook::clear() {
+  orders_.clear();
+  pool_.clear();
+  free_.clear();
+  bids_.clear();
+  asks_.clear();
+}
+
+Bbo OrderBook::bbo() const {
+  return {view(bids_, 0), view(asks_, 0)};
+}
+
+PriceLevel OrderBook::bid_level(size_t depth) const {
+  return view(bids_, depth);
+}
+
+PriceLevel OrderBook::ask_level(size_t depth) const {
+  return view(asks_, depth);
+}
+
+size_t OrderBook::bids(std::span<PriceLevel> out) const {
+  const size_t n = std::min(out.size(), bids_.size());
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = view(bids_, i);
+  }
+  return n;
+}
+
+size_t OrderBook::asks(std::span<PriceLevel> out) const {
+  const size_t n = std::min(out.size(), asks_.size());
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = view(asks_, i);
+  }
+  return n;
+}
+
+// ============================================================================
+// BookBuilder Implementation
+// ============================================================================
+
+OrderBook& BookBuilder::book(uint32_t instrument_id) {
+  if (last_ != nullptr && last_id_ == instrument_id) {
+    return *last_;
+  }
+  auto& slot = books_[instrument_id];
+  if (!slot) {
+    slot = std::make_unique<OrderBook>();
+  }
+  last_id_ = instrument_id;
+  last_ = slot.get();
+  return *last_;
+}
+
+const OrderBook* BookBuilder::find(uint32_t instrument_id) const {
+  auto it = books_.find(instrument_id);
+  return it == books_.end() ? nullptr : it->second.get();
+}
+
+} // namespace databento
@@ -0,0 +1,121 @@
+#include "databento/buffer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+
+namespace databento {
+
+// ============================================================================
+// Huge Pages
+// ============================================================================
+
+const char* page_backing_name(PageBacking backing) {
+  switch (backing) {
+    case PageBacking::Heap: return "heap";
+    case PageBacking::Small: return "4k";
+    case PageBacking::Transparent: return "thp";
+    case PageBacking::HugeTlb: return "hugetlb";
+  }
+  return "unknown";
+}
+
+namespace {
+
+size_t round_up_huge(size_t bytes) {
+  return (std::max<size_t>(bytes, 1) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+// Anonymous mapping of len bytes at a HUGE_PAGE_SIZE boundary: over-reserve
+// by one huge page, then unmap the misaligned head and the tail
+void* map_aligned(size_t len) {
+  const size_t reserve = len + HUGE_PAGE_SIZE;
+  void* raw = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto start = reinterpret_cast<uintptr_t>(raw);
+  const uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+  if (aligned > start) {
+    munmap(raw, aligned - start);
+  }
+  const size_t tail = start + reserve - (aligned + len);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void*>(aligned + len), tail);
+  }
+  return reinterpret_cast<void*>(aligned);
+}
+
+} // namespace
+
+PageAllocation allocate_pages(size_t bytes, HugePages mode) {
+  PageAllocation allocation;
+  allocation.bytes = round_up_huge(bytes);
+
+  if (mode == HugePages::HugeTlb) {
+    void* addr = mmap(nullptr, allocation.bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr != MAP_FAILED) {
+      allocation.addr = addr;
+      allocation.backing = PageBacking::HugeTlb;
+      return allocation;
+    }
+    // Pool empty or not configured (vm.nr_hugepages = 0)
+  }
+
+  allocation.addr = map_aligned(allocation.bytes);
+  if (allocation.addr == nullptr) {
+    throw std::bad_alloc();
+  }
+  allocation.backing = PageBacking::Small;
+  if (mode != HugePages::Off && madvise(allocation.addr, allocation.bytes, MADV_HUGEPAGE) == 0) {
+    allocation.backing = PageBacking::Transparent;
+  }
+  return allocation;
+}
+
+void free_pages(const PageAllocation& allocation) {
+  if (allocation.addr != nullptr) {
+    munmap(allocation.addr, allocation.bytes);
+  }
+}
+
+size_t huge_page_bytes(const void* addr, size_t len) {
+  FILE* smaps = std::fopen("/proc/self/smaps", "r");
+  if (smaps == nullptr) {
+    return 0;
+  }
+
+  const auto begin = reinterpret_cast<uintptr_t>(addr);
+  const uintptr_t end = begin + len;
+  size_t total = 0;
+  size_t vma_huge = 0;
+  size_t vma_overlap = 0;
+  char line[512];
+  while (std::fgets(line, sizeof(line), smaps) != nullptr) {
+    unsigned long lo = 0;
+    unsigned long hi = 0;
+    unsigned long kb = 0;
+    char field[64];
+    if (std::sscanf(line, "%lx-%lx ", &lo, &hi) == 2) {
+      // New VMA header: settle the previous one
+      total += std::min(vma_huge, vma_overlap);
+      vma_huge = 0;
+      vma_overlap = lo < end && hi > begin
+                        ? std::min<uintptr_t>(hi, end) - std::max<uintptr_t>(lo, begin)
+                        : 0;
+    } else if (vma_overlap > 0 && std::sscanf(line, "%63[^:]: %lu kB", field, &kb) == 2 &&
+               (std::strcmp(field, "AnonHugePages") == 0 ||
+                std::strcmp(field, "FilePmdMapped") == 0 ||
+                std::strcmp(field, "Private_Hugetlb") == 0 ||
+                std::strcmp(field, "Shared_Hugetlb") == 0)) {
+      vma_huge += kb * 1024;
+    }
+  }
+  total += std::min(vma_huge, vma_overlap);
+  std::fclose(smaps);
+  return total;
+}
+
+} // namespace databento
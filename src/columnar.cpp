@@ -0,0 +1,251 @@
+#include "databento/columnar.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "simd_gather.hpp"
+
+namespace databento {
+
+namespace {
+
+// ============================================================================
+// Strided Gather Kernels
+// ============================================================================
+
+// Each kernel reads one field from count records stride bytes apart
+// (base already points at the field in the first record)
+
+DATABENTO_GATHER_BEGIN
+
+void gather_u64(const uint8_t* base, size_t count, size_t stride, void* dst) {
+  auto* out = static_cast<uint8_t*>(dst);
+  size_t i = 0;
+#if defined(__AVX512F__)
+  const long long s = static_cast<long long>(stride);
+  const __m512i index = _mm512_set_epi64(7 * s, 6 * s, 5 * s, 4 * s, 3 * s, 2 * s, s, 0);
+  for (; i + 8 <= count; i += 8) {
+    const __m512i v = _mm512_i64gather_epi64(index, base + i * stride, 1);
+    _mm512_storeu_si512(out + i * 8, v);
+  }
+#elif defined(__AVX2__)
+  const long long s = static_cast<long long>(stride);
+  const __m256i index = _mm256_set_epi64x(3 * s, 2 * s, s, 0);
+  for (; i + 4 <= count; i += 4) {
+    const __m256i v = _mm256_i64gather_epi64(
+        reinterpret_cast<const long long*>(base + i * stride), index, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), v);
+  }
+#endif
+  for (; i < count; ++i) {
+    std::memcpy(out + i * 8, base + i * stride, 8);
+  }
+}
+
+void gather_u32(const uint8_t* base, size_t count, size_t stride, void* dst) {
+  auto* out = static_cast<uint8_t*>(dst);
+  size_t i = 0;
+#if defined(__AVX512F__)
+  const int s = static_cast<int>(stride);
+  const __m512i index = _mm512_mullo_epi32(
+      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+      _mm512_set1_epi32(s));
+  for (; i + 16 <= count; i += 16) {
+    const __m512i v = _mm512_i32gather_epi32(index, base + i * stride, 1);
+    _mm512_storeu_si512(out + i * 4, v);
+  }
+#elif defined(__AVX2__)
+  const int s = static_cast<int>(stride);
+  const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                           _mm256_set1_epi32(s));
+  for (; i + 8 <= count; i += 8) {
+    const __m256i v = _mm256_i32gather_epi32(
+        reinterpret_cast<const int*>(base + i * stride), index, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), v);
+  }
+#endif
+  for (; i < count; ++i) {
+    std::memcpy(out + i * 4, base + i * stride, 4);
+  }
+}
+
+// Byte fields are gathered as the dword at base and narrowed, so the read
+// never leaves the record; byte selects which of its 4 bytes to keep
+void gather_u8(const uint8_t* base, size_t count, size_t stride, unsigned byte, void* dst) {
+  auto* out = static_cast<uint8_t*>(dst);
+  size_t i = 0;
+#if defined(__AVX512F__)
+  const int s = static_cast<int>(stride);
+  const __m512i index = _mm512_mullo_epi32(
+      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+      _mm512_set1_epi32(s));
+  const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(byte * 8));
+  for (; i + 16 <= count; i += 16) {
+    __m512i v = _mm512_i32gather_epi32(index, base + i * stride, 1);
+    v = _mm512_srl_epi32(v, shift);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm512_cvtepi32_epi8(v));
+  }
+#elif defined(__AVX2__)
+  const int s = static_cast<int>(stride);
+  const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                           _mm256_set1_epi32(s));
+  const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(byte * 8));
+  // Low byte of each dword to the front of each 128-bit lane, then join lanes
+  const __m256i pick = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i join = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+  for (; i + 8 <= count; i += 8) {
+    __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + i * stride), index, 1);
+    v = _mm256_srl_epi32(v, shift);
+    v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, pick), join);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(v));
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = base[i * stride + byte];
+  }
+}
+
+DATABENTO_GATHER_END
+
+} // namespace
+
+// ============================================================================
+// Columnar Decoding
+// ============================================================================
+
+void MboColumns::set_huge_pages(HugePages mode) {
+  ts_event.set_huge_pages(mode);
+  instrument_id.set_huge_pages(mode);
+  action.set_huge_pages(mode);
+  side.set_huge_pages(mode);
+  flags.set_huge_pages(mode);
+  depth.set_huge_pages(mode);
+  price.set_huge_pages(mode);
+  size.set_huge_pages(mode);
+  channel_id.set_huge_pages(mode);
+  order_id.set_huge_pages(mode);
+  sequence.set_huge_pages(mode);
+  ts_in_delta.set_huge_pages(mode);
+}
+
+void decode_mbo_columns(const uint8_t* records, size_t count, size_t rec_size,
+                        uint32_t columns, MboColumns& out) {
+  out.count = count;
+  out.columns = columns;
+
+  // Unselected columns are emptied so stale data can't be mistaken for
+  // this batch
+  auto column = [&](uint32_t bit, auto& buffer) {
+    buffer.resize((columns & bit) ? count : 0);
+    return (columns & bit) != 0;
+  };
+
+  // Byte fields share the dword at offset 12 (action, side, flags, depth)
+  // and at offset 44 (ts_in_delta + reserved)
+  constexpr size_t byte_word = offsetof(MboMsg, action);
+  constexpr size_t delta_word = offsetof(MboMsg, ts_in_delta);
+
+  if (column(COL_TS_EVENT, out.ts_event)) {
+    gather_u64(records + offsetof(MboMsg, ts_event), count, rec_size, out.ts_event.data());
+  }
+  if (column(COL_INSTRUMENT_ID, out.instrument_id)) {
+    gather_u32(records + offsetof(MboMsg, instrument_id), count, rec_size, out.instrument_id.data());
+  }
+  if (column(COL_ACTION, out.action)) {
+    gather_u8(records + byte_word, count, rec_size, offsetof(MboMsg, action) - byte_word, out.action.data());
+  }
+  if (column(COL_SIDE, out.side)) {
+    gather_u8(records + byte_word, count, rec_size, offsetof(MboMsg, side) - byte_word, out.side.data());
+  }
+  if (column(COL_FLAGS, out.flags)) {
+    gather_u8(records + byte_word, count, rec_size, offsetof(MboMsg, flags) - byte_word, out.flags.data());
+  }
+  if (column(COL_DEPTH, out.depth)) {
+    gather_u8(records + byte_word, count, rec_size, offsetof(MboMsg, depth) - byte_word, out.depth.data());
+  }
+  if (column(COL_PRICE, out.price)) {
+    gather_u64(records + offsetof(MboMsg, price), count, rec_size, out.price.data());
+  }
+  if (column(COL_SIZE, out.size)) {
+    gather_u32(records + offsetof(MboMsg, size), count, rec_size, out.size.data());
+  }
+  if (column(COL_CHANNEL_ID, out.channel_id)) {
+    gather_u32(records + offsetof(MboMsg, channel_id), count, rec_size, out.channel_id.data());
+  }
+  if (column(COL_ORDER_ID, out.order_id)) {
+    gather_u64(records + offsetof(MboMsg, order_id), count, rec_size, out.order_id.data());
+  }
+  if (column(COL_SEQUENCE, out.sequence)) {
+    gather_u32(records + offsetof(MboMsg, sequence), count, rec_size, out.sequence.data());
+  }
+  if (column(COL_TS_IN_DELTA, out.ts_in_delta)) {
+    gather_u8(records + delta_word, count, rec_size, 0, out.ts_in_delta.data());
+  }
+}
+
+// ============================================================================
+// MBP Ladder Decoding
+// ============================================================================
+
+void MbpLadders::set_huge_pages(HugePages mode) {
+  bid_px.set_huge_pages(mode);
+  ask_px.set_huge_pages(mode);
+  bid_sz.set_huge_pages(mode);
+  ask_sz.set_huge_pages(mode);
+  bid_ct.set_huge_pages(mode);
+  ask_ct.set_huge_pages(mode);
+}
+
+void decode_mbp_ladders(const uint8_t* records, size_t count, size_t rec_size,
+                        size_t levels, MbpLadders& out) {
+  constexpr size_t header = offsetof(Mbp10Msg, levels);
+  if (rec_size < header + levels * sizeof(BidAskPair)) {
+    throw std::invalid_argument("Records are too small for " + std::to_string(levels) +
+                                " book levels");
+  }
+
+  out.count = count;
+  out.levels = levels;
+  const size_t cells = count * levels;
+  out.bid_px.resize(cells);
+  out.ask_px.resize(cells);
+  out.bid_sz.resize(cells);
+  out.ask_sz.resize(cells);
+  out.bid_ct.resize(cells);
+  out.ask_ct.resize(cells);
+
+  // Work through tiles small enough to stay in L1, so the 6 * levels
+  // gathers over a tile hit cache after its first pass
+  constexpr size_t tile_bytes = 24 * 1024;
+  const size_t tile = std::max<size_t>(tile_bytes / rec_size, 16);
+
+  for (size_t start = 0; start < count; start += tile) {
+    const size_t n = std::min(tile, count - start);
+    const uint8_t* base = records + start * rec_size + header;
+    for (size_t level = 0; level < levels; ++level) {
+      const uint8_t* pair = base + level * sizeof(BidAskPair);
+      const size_t at = level * count + start;
+      gather_u64(pair + offsetof(BidAskPair, bid_px), n, rec_size, out.bid_px.data() + at);
+      gather_u64(pair + offsetof(BidAskPair, ask_px), n, rec_size, out.ask_px.data() + at);
+      gather_u32(pair + offsetof(BidAskPair, bid_sz), n, rec_size, out.bid_sz.data() + at);
+      gather_u32(pair + offsetof(BidAskPair, ask_sz), n, rec_size, out.ask_sz.data() + at);
+      gather_u32(pair + offsetof(BidAskPair, bid_ct), n, rec_size, out.bid_ct.data() + at);
+      gather_u32(pair + offsetof(BidAskPair, ask_ct), n, rec_size, out.ask_ct.data() + at);
+    }
+  }
+}
+
+const char* columnar_simd_level() {
+#if defined(__AVX512F__)
+  return "avx512";
+#elif defined(__AVX2__)
+  return "avx2";
+#else
+  return "scalar";
+#endif
+}
+
+} // namespace databento
@@ -0,0 +1,295 @@
+#include "databento/filter.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "simd_gather.hpp"
+
+namespace databento {
+
+namespace {
+
+// Instrument sets up to this size are tested with broadcast compares;
+// larger ones by binary search on the records that pass everything else
+constexpr size_t SIMD_ID_SET_MAX = 16;
+
+constexpr size_t TS_OFFSET = offsetof(MboMsg, ts_event);
+constexpr size_t ID_OFFSET = offsetof(MboMsg, instrument_id);
+constexpr size_t WORD_OFFSET = offsetof(MboMsg, action); // action, side, flags, depth
+constexpr size_t PRICE_OFFSET = offsetof(MboMsg, price);
+
+// Filter lowered to the checks that actually constrain something
+struct Predicate {
+  bool use_word;
+  uint32_t word_mask;   // Action in byte 0, side in byte 1
+  uint32_t word_value;
+  bool use_price;
+  int64_t min_price;
+  int64_t max_price;
+  bool use_ts;
+  uint64_t min_ts;
+  uint64_t max_ts;
+  bool use_ids;
+  bool small_ids;
+  std::vector<uint32_t> ids; // Sorted
+
+  explicit Predicate(const MboFilter& f)
+      : use_word(f.action != 0 || f.side != 0),
+        word_mask((f.action != 0 ? 0x00FFu : 0u) | (f.side != 0 ? 0xFF00u : 0u)),
+        word_value(static_cast<uint8_t>(f.action) | (static_cast<uint32_t>(static_cast<uint8_t>(f.side)) << 8)),
+        use_price(f.min_price != std::numeric_limits<int64_t>::min() ||
+                  f.max_price != std::numeric_limits<int64_t>::max()),
+        min_price(f.min_price),
+        max_price(f.max_price),
+        use_ts(f.min_ts != 0 || f.max_ts != std::numeric_limits<uint64_t>::max()),
+        min_ts(f.min_ts),
+        max_ts(f.max_ts),
+        use_ids(!f.instrument_ids.empty()),
+        ids(f.instrument_ids) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    small_ids = ids.size() <= SIMD_ID_SET_MAX;
+  }
+
+  bool has_id(uint32_t id) const {
+    return std::binary_search(ids.begin(), ids.end(), id);
+  }
+
+  bool matches(const uint8_t* record) const {
+    if (use_word && (read_u32_le(record + WORD_OFFSET) & word_mask) != word_value) {
+      return false;
+    }
+    if (use_price) {
+      const int64_t price = read_i64_le(record + PRICE_OFFSET);
+      if (price < min_price || price > max_price) {
+        return false;
+      }
+    }
+    if (use_ts) {
+      const uint64_t ts = read_u64_le(record + TS_OFFSET);
+      if (ts < min_ts || ts > max_ts) {
+        return false;
+      }
+    }
+    return !use_ids || has_id(read_u32_le(record + ID_OFFSET));
+  }
+};
+
+// Append indices for the set bits of mask (records i + bit); large
+// instrument sets are checked here, on survivors only
+inline size_t emit_mask(uint32_t mask, size_t i, const uint8_t* base, size_t stride,
+                        const Predicate& pred, uint32_t* out, size_t n) {
+  while (mask != 0) {
+    const unsigned bit = static_cast<unsigned>(std::countr_zero(mask));
+    mask &= mask - 1;
+    if (pred.use_ids && !pred.small_ids &&
+        !pred.has_id(read_u32_le(base + bit * stride + ID_OFFSET))) {
+      continue;
+    }
+    out[n++] = static_cast<uint32_t>(i + bit);
+  }
+  return n;
+}
+
+DATABENTO_GATHER_BEGIN
+
+#if defined(__AVX512F__)
+
+// 16 records per iteration; 64-bit fields are gathered as two halves
+size_t select_simd(const uint8_t* records, size_t count, size_t stride,
+                   const Predicate& pred, uint32_t* out, size_t& i) {
+  const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const __m512i index = _mm512_mullo_epi32(lanes, _mm512_set1_epi32(static_cast<int>(stride)));
+  const __m256i index_lo = _mm512_castsi512_si256(index);
+  const __m256i index_hi = _mm512_extracti64x4_epi64(index, 1);
+
+  const __m512i word_mask = _mm512_set1_epi32(static_cast<int>(pred.word_mask));
+  const __m512i word_value = _mm512_set1_epi32(static_cast<int>(pred.word_value));
+  const __m512i min_price = _mm512_set1_epi64(pred.min_price);
+  const __m512i max_price = _mm512_set1_epi64(pred.max_price);
+  const __m512i min_ts = _mm512_set1_epi64(static_cast<long long>(pred.min_ts));
+  const __m512i max_ts = _mm512_set1_epi64(static_cast<long long>(pred.max_ts));
+
+  size_t n = 0;
+  for (; i + 16 <= count; i += 16) {
+    const uint8_t* base = records + i * stride;
+    __mmask16 m = 0xFFFF;
+
+    if (pred.use_word) {
+      const __m512i w = _mm512_i32gather_epi32(index, base + WORD_OFFSET, 1);
+      m &= _mm512_cmpeq_epi32_mask(_mm512_and_si512(w, word_mask), word_value);
+      if (m == 0) continue;
+    }
+    if (pred.use_price) {
+      const __m512i lo = _mm512_i32gather_epi64(index_lo, base + PRICE_OFFSET, 1);
+      const __m512i hi = _mm512_i32gather_epi64(index_hi, base + PRICE_OFFSET, 1);
+      const __mmask8 ml = _mm512_cmpge_epi64_mask(lo, min_price) & _mm512_cmple_epi64_mask(lo, max_price);
+      const __mmask8 mh = _mm512_cmpge_epi64_mask(hi, min_price) & _mm512_cmple_epi64_mask(hi, max_price);
+      m &= static_cast<__mmask16>(ml | (mh << 8));
+      if (m == 0) continue;
+    }
+    if (pred.use_ts) {
+      const __m512i lo = _mm512_i32gather_epi64(index_lo, base + TS_OFFSET, 1);
+      const __m512i hi = _mm512_i32gather_epi64(index_hi, base + TS_OFFSET, 1);
+      const __mmask8 ml = _mm512_cmpge_epu64_mask(lo, min_ts) & _mm512_cmple_epu64_mask(lo, max_ts);
+      const __mmask8 mh = _mm512_cmpge_epu64_mask(hi, min_ts) & _mm512_cmple_epu64_mask(hi, max_ts);
+      m &= static_cast<__mmask16>(ml | (mh << 8));
+      if (m == 0) continue;
+    }
+    if (pred.use_ids && pred.small_ids) {
+      const __m512i ids = _mm512_i32gather_epi32(index, base + ID_OFFSET, 1);
+      __mmask16 mi = 0;
+      for (uint32_t id : pred.ids) {
+        mi |= _mm512_cmpeq_epi32_mask(ids, _mm512_set1_epi32(static_cast<int>(id)));
+      }
+      m &= mi;
+      if (m == 0) continue;
+    }
+
+    if (pred.use_ids && !pred.small_ids) {
+      n = emit_mask(m, i, base, stride, pred, out, n);
+    } else {
+      const __m512i idx = _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int>(i)));
+      _mm512_mask_compressstoreu_epi32(out + n, m, idx);
+      n += static_cast<size_t>(std::popcount(static_cast<unsigned>(m)));
+    }
+  }
+  return n;
+}
+
+#elif defined(__AVX2__)
+
+// AVX2 lacks unsigned 64-bit compares; flip the sign bit to compare signed
+inline __m256i to_signed(__m256i v) {
+  return _mm256_xor_si256(v, _mm256_set1_epi64x(static_cast<long long>(1ULL << 63)));
+}
+
+// Lanes of v outside [lo, hi] (signed), as a 4-bit mask
+inline uint32_t out_of_range(__m256i v, __m256i lo, __m256i hi) {
+  const __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi64(lo, v), _mm256_cmpgt_epi64(v, hi));
+  return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(bad)));
+}
+
+// 8 records per iteration; 64-bit fields are gathered as two halves
+size_t select_simd(const uint8_t* records, size_t count, size_t stride,
+                   const Predicate& pred, uint32_t* out, size_t& i) {
+  const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                           _mm256_set1_epi32(static_cast<int>(stride)));
+  const __m128i index_lo = _mm256_castsi256_si128(index);
+  const __m128i index_hi = _mm256_extracti128_si256(index, 1);
+
+  const __m256i word_mask = _mm256_set1_epi32(static_cast<int>(pred.word_mask));
+  const __m256i word_value = _mm256_set1_epi32(static_cast<int>(pred.word_value));
+  const __m256i min_price = _mm256_set1_epi64x(pred.min_price);
+  const __m256i max_price = _mm256_set1_epi64x(pred.max_price);
+  const __m256i min_ts = to_signed(_mm256_set1_epi64x(static_cast<long long>(pred.min_ts)));
+  const __m256i max_ts = to_signed(_mm256_set1_epi64x(static_cast<long long>(pred.max_ts)));
+
+  size_t n = 0;
+  for (; i + 8 <= count; i += 8) {
+    const uint8_t* base = records + i * stride;
+    uint32_t m = 0xFF;
+
+    if (pred.use_word) {
+      const __m256i w = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + WORD_OFFSET), index, 1);
+      const __m256i eq = _mm256_cmpeq_epi32(_mm256_and_si256(w, word_mask), word_value);
+      m &= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+      if (m == 0) continue;
+    }
+    if (pred.use_price) {
+      const auto* p = reinterpret_cast<const long long*>(base + PRICE_OFFSET);
+      const uint32_t bad = out_of_range(_mm256_i32gather_epi64(p, index_lo, 1), min_price, max_price) |
+                           (out_of_range(_mm256_i32gather_epi64(p, index_hi, 1), min_price, max_price) << 4);
+      m &= ~bad;
+      if (m == 0) continue;
+    }
+    if (pred.use_ts) {
+      const auto* p = reinterpret_cast<const long long*>(base + TS_OFFSET);
+      const uint32_t bad = out_of_range(to_signed(_mm256_i32gather_epi64(p, index_lo, 1)), min_ts, max_ts) |
+                           (out_of_range(to_signed(_mm256_i32gather_epi64(p, index_hi, 1)), min_ts, max_ts) << 4);
+      m &= ~bad;
+      if (m == 0) continue;
+    }
+    if (pred.use_ids && pred.small_ids) {
+      const __m256i ids = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + ID_OFFSET), index, 1);
+      __m256i hit = _mm256_setzero_si256();
+      for (uint32_t id : pred.ids) {
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(ids, _mm256_set1_epi32(static_cast<int>(id))));
+      }
+      m &= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+      if (m == 0) continue;
+    }
+
+    n = emit_mask(m, i, base, stride, pred, out, n);
+  }
+  return n;
+}
+
+#else
+
+size_t select_simd(const uint8_t*, size_t, size_t, const Predicate&, uint32_t*, size_t&) {
+  return 0;
+}
+
+#endif
+
+DATABENTO_GATHER_END
+
+} // namespace
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+size_t select_mbo(const uint8_t* records, size_t count, size_t rec_size,
+                  const MboFilter& filter, AlignedBuffer<uint32_t>& selection) {
+  if (count > UINT32_MAX) {
+    throw std::invalid_argument("select_mbo selects at most 2^32 - 1 records per call");
+  }
+  const Predicate pred(filter);
+  selection.resize(count);
+  uint32_t* out = selection.data();
+
+  size_t i = 0;
+  size_t n = select_simd(records, count, rec_size, pred, out, i);
+
+  // Scalar tail (or the whole range without SIMD), branch-free append
+  for (; i < count; ++i) {
+    out[n] = static_cast<uint32_t>(i);
+    n += pred.matches(records + i * rec_size) ? 1 : 0;
+  }
+
+  selection.resize(n);
+  return n;
+}
+
+std::vector<uint64_t> select_mbo(DbnParser& parser, const MboFilter& filter) {
+  // Predicates read MboMsg offsets, which TradeMsg shares
+  if (parser.schema() != RType::Mbo && parser.schema() != RType::Trade) {
+    throw std::invalid_argument("Selection needs an MBO or trades file");
+  }
+  if (!parser.data()) {
+    parser.load_with_mmap();
+  }
+
+  // Keep per-call selection vectors small and 32-bit, and blocks within
+  // a sliding mmap window
+  const size_t block = std::min<size_t>(1 << 20, parser.mmap_window_step());
+  const size_t total = parser.num_records();
+  std::vector<uint64_t> result;
+  AlignedBuffer<uint32_t> selection;
+
+  for (size_t start = 0; start < total; start += block) {
+    const size_t count = std::min(block, total - start);
+    parser.advance_mmap_window(start);
+    select_mbo(parser.get_batch(start, count), count, parser.record_size(), filter, selection);
+    for (uint32_t idx : selection) {
+      result.push_back(start + idx);
+    }
+  }
+  return result;
+}
+
+} // namespace databento
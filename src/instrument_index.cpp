@@ -0,0 +1,262 @@
+#include "databento/instrument_index.hpp"
+#include "databento/dbn.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace databento {
+
+namespace {
+
+constexpr char SIDECAR_MAGIC[8] = {'D', 'B', 'N', 'I', 'D', 'X', '\0', '\0'};
+
+// Fixed-size sidecar header, followed by num_instruments table rows
+// (instrument_id, count, offset, bytes) and the varint payload
+struct SidecarHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_instruments;
+  uint64_t num_records;
+  uint64_t source_size;
+  int64_t source_mtime_ns;
+  uint64_t payload_bytes;
+  uint64_t checksum; // FNV-1a over the table and payload
+};
+
+struct SidecarRow {
+  uint32_t instrument_id;
+  uint32_t reserved;
+  uint64_t count;
+  uint64_t offset;
+  uint64_t bytes;
+};
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t fnv1a(const void* data, size_t len, uint64_t hash = 0xcbf29ce484222325ULL) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < len; ++i) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Decode count varint deltas from [ptr, end) and check that they consume
+// exactly that range and every record index is below num_records
+bool valid_entry(const uint8_t* ptr, const uint8_t* end, uint64_t count, uint64_t num_records) {
+  uint64_t index = 0;
+  for (uint64_t n = 0; n < count; ++n) {
+    uint64_t delta = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+    do {
+      if (ptr == end || shift > 63) {
+        return false;
+      }
+      byte = *ptr++;
+      delta |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    // Indices ascend strictly; only the first delta may be zero
+    if ((n > 0 && delta == 0) || delta >= num_records - index) {
+      return false;
+    }
+    index += delta;
+  }
+  return ptr == end;
+}
+
+} // namespace
+
+// ============================================================================
+// Building
+// ============================================================================
+
+InstrumentIndex InstrumentIndex::build(const uint8_t* records, size_t count, size_t rec_size) {
+  struct Builder {
+    uint64_t last = 0;
+    uint64_t count = 0;
+    std::vector<uint8_t> bytes;
+  };
+  std::unordered_map<uint32_t, Builder> builders;
+
+  // Consecutive records often share an instrument; skip the hash lookup
+  uint32_t cached_id = 0;
+  Builder* cached = nullptr;
+
+  const uint8_t* ptr = records + offsetof(MboMsg, instrument_id);
+  for (size_t i = 0; i < count; ++i, ptr += rec_size) {
+    const uint32_t id = read_u32_le(ptr);
+    if (cached == nullptr || id != cached_id) {
+      cached = &builders[id];
+      cached_id = id;
+    }
+    put_varint(cached->bytes, i - cached->last);
+    cached->last = i;
+    ++cached->count;
+  }
+
+  // Payload is laid out by ascending instrument id
+  std::vector<uint32_t> ids;
+  ids.reserve(builders.size());
+  size_t payload_bytes = 0;
+  for (const auto& [id, builder] : builders) {
+    ids.push_back(id);
+    payload_bytes += builder.bytes.size();
+  }
+  std::sort(ids.begin(), ids.end());
+
+  InstrumentIndex index;
+  index.num_records_ = count;
+  index.payload_.reserve(payload_bytes);
+  index.entries_.reserve(ids.size());
+  for (uint32_t id : ids) {
+    const Builder& builder = builders[id];
+    index.entries_[id] = {builder.count, index.payload_.size(), builder.bytes.size()};
+    index.payload_.insert(index.payload_.end(), builder.bytes.begin(), builder.bytes.end());
+  }
+  return index;
+}
+
+// ============================================================================
+// Sidecar Persistence
+// ============================================================================
+
+void InstrumentIndex::save(const std::string& path, uint64_t source_size,
+                           int64_t source_mtime_ns) const {
+  SidecarHeader header{};
+  std::memcpy(header.magic, SIDECAR_MAGIC, sizeof(header.magic));
+  header.version = FORMAT_VERSION;
+  header.num_instruments = static_cast<uint32_t>(entries_.size());
+  header.num_records = num_records_;
+  header.source_size = source_size;
+  header.source_mtime_ns = source_mtime_ns;
+  header.payload_bytes = payload_.size();
+
+  std::vector<SidecarRow> rows;
+  rows.reserve(entries_.size());
+  for (uint32_t id : instruments()) {
+    const Entry& entry = entries_.at(id);
+    rows.push_back({id, 0, entry.count, entry.offset, entry.bytes});
+  }
+  header.checksum = fnv1a(payload_.data(), payload_.size(),
+                          fnv1a(rows.data(), rows.size() * sizeof(SidecarRow)));
+
+  // Write to a temporary name and rename, so readers never see a torn file
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      throw std::runtime_error("Failed to create index file: " + tmp);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(rows.data()), rows.size() * sizeof(SidecarRow));
+    file.write(reinterpret_cast<const char*>(payload_.data()), payload_.size());
+    if (!file) {
+      std::remove(tmp.c_str());
+      throw std::runtime_error("Failed to write index file: " + tmp);
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    throw std::runtime_error("Failed to write index file: " + path);
+  }
+}
+
+std::optional<InstrumentIndex> InstrumentIndex::load(const std::string& path,
+                                                     uint64_t source_size,
+                                                     int64_t source_mtime_ns,
+                                                     uint64_t num_records) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return std::nullopt;
+  }
+  const auto file_size = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+
+  SidecarHeader header;
+  if (file_size < sizeof(header) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, SIDECAR_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != FORMAT_VERSION ||
+      header.source_size != source_size ||
+      header.source_mtime_ns != source_mtime_ns ||
+      header.num_records != num_records) {
+    return std::nullopt;
+  }
+
+  // The table and payload must fill the rest of the file exactly; check
+  // before allocating anything the header asks for
+  const uint64_t body = file_size - sizeof(header);
+  if (header.num_instruments > body / sizeof(SidecarRow) ||
+      header.payload_bytes != body - header.num_instruments * sizeof(SidecarRow)) {
+    return std::nullopt;
+  }
+
+  std::vector<SidecarRow> rows(header.num_instruments);
+  InstrumentIndex index;
+  index.num_records_ = header.num_records;
+  index.payload_.resize(header.payload_bytes);
+  if (!file.read(reinterpret_cast<char*>(rows.data()), rows.size() * sizeof(SidecarRow)) ||
+      !file.read(reinterpret_cast<char*>(index.payload_.data()), index.payload_.size()) ||
+      fnv1a(index.payload_.data(), index.payload_.size(),
+            fnv1a(rows.data(), rows.size() * sizeof(SidecarRow))) != header.checksum) {
+    return std::nullopt;
+  }
+
+  // Every record belongs to exactly one instrument
+  uint64_t total = 0;
+  index.entries_.reserve(rows.size());
+  for (const SidecarRow& row : rows) {
+    if (row.offset > header.payload_bytes || row.bytes > header.payload_bytes - row.offset ||
+        row.count > num_records - total) {
+      return std::nullopt;
+    }
+    const uint8_t* begin = index.payload_.data() + row.offset;
+    if (!valid_entry(begin, begin + row.bytes, row.count, num_records) ||
+        !index.entries_.emplace(row.instrument_id, Entry{row.count, row.offset, row.bytes}).second) {
+      return std::nullopt;
+    }
+    total += row.count;
+  }
+  if (total != num_records) {
+    return std::nullopt;
+  }
+  return index;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+std::vector<uint32_t> InstrumentIndex::instruments() const {
+  std::vector<uint32_t> ids;
+  ids.reserve(entries_.size());
+  for (const auto& [id, entry] : entries_) {
+    ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+size_t InstrumentIndex::count(uint32_t instrument_id) const {
+  auto it = entries_.find(instrument_id);
+  return it == entries_.end() ? 0 : it->second.count;
+}
+
+std::vector<uint64_t> InstrumentIndex::records(uint32_t instrument_id) const {
+  std::vector<uint64_t> out;
+  out.reserve(count(instrument_id));
+  for_each(instrument_id, [&](size_t index) { out.push_back(index); });
+  return out;
+}
+
+} // namespace databento
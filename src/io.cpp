@@ -0,0 +1,366 @@
+#include "databento/io.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace databento {
+
+const char* io_backend_name(IoBackend backend) {
+  switch (backend) {
+    case IoBackend::None: return "none";
+    case IoBackend::Ifstream: return "ifstream";
+    case IoBackend::Mmap: return "mmap";
+    case IoBackend::Pread: return "pread";
+    case IoBackend::IoUring: return "io_uring";
+    case IoBackend::Zstd: return "zstd";
+    case IoBackend::Direct: return "direct";
+  }
+  return "unknown";
+}
+
+// ============================================================================
+// Positional Reads
+// ============================================================================
+
+size_t pread_fully(int fd, uint8_t* dst, size_t len, off_t offset) {
+  size_t total = 0;
+  while (total < len) {
+    ssize_t n = pread(fd, dst + total, len - total, offset + total);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(std::string("Failed to read file: ") + std::strerror(errno));
+    }
+    if (n == 0) {
+      break;
+    }
+    total += n;
+  }
+  return total;
+}
+
+void pwrite_fully(int fd, const uint8_t* src, size_t len, off_t offset) {
+  size_t total = 0;
+  while (total < len) {
+    ssize_t n = pwrite(fd, src + total, len - total, offset + total);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(std::string("Failed to write file: ") + std::strerror(errno));
+    }
+    total += n;
+  }
+}
+
+size_t pread_direct(int fd, uint8_t* dst, size_t len, off_t offset) {
+  size_t total = 0;
+  while (total < len) {
+    ssize_t n = pread(fd, dst + total, len - total, offset + total);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(std::string("Failed to read file: ") + std::strerror(errno));
+    }
+    total += n;
+    if (n == 0 || n % DIRECT_IO_ALIGNMENT != 0) {
+      break; // End of file
+    }
+  }
+  return total;
+}
+
+// ============================================================================
+// IoUring Implementation
+// ============================================================================
+
+IoUring::IoUring(unsigned entries)
+    : ring_fd_(-1),
+      entries_(0),
+      to_submit_(0),
+      sq_ptr_(MAP_FAILED),
+      sq_len_(0),
+      cq_ptr_(MAP_FAILED),
+      cq_len_(0),
+      sqes_(nullptr),
+      sqes_len_(0) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, std::max(entries, 1u), &params));
+  if (ring_fd_ < 0) {
+    throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+  }
+  entries_ = params.sq_entries;
+
+  sq_len_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_len_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_len_ = cq_len_ = std::max(sq_len_, cq_len_);
+  }
+
+  sq_ptr_ = mmap(nullptr, sq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ptr_ != MAP_FAILED) {
+    cq_ptr_ = single_mmap ? sq_ptr_
+                          : mmap(nullptr, cq_len_, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+  }
+  sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = MAP_FAILED;
+  if (cq_ptr_ != MAP_FAILED) {
+    sqes = mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                ring_fd_, IORING_OFF_SQES);
+  }
+  if (sqes == MAP_FAILED) {
+    const int err = errno;
+    release();
+    throw std::system_error(err, std::generic_category(), "io_uring mmap");
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  auto* sq = static_cast<uint8_t*>(sq_ptr_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  auto* cq = static_cast<uint8_t*>(cq_ptr_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+}
+
+IoUring::~IoUring() {
+  release();
+}
+
+void IoUring::release() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_len_);
+    sqes_ = nullptr;
+  }
+  if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+    munmap(cq_ptr_, cq_len_);
+  }
+  cq_ptr_ = MAP_FAILED;
+  if (sq_ptr_ != MAP_FAILED) {
+    munmap(sq_ptr_, sq_len_);
+    sq_ptr_ = MAP_FAILED;
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+bool IoUring::supported() {
+  static const bool ok = []() {
+    try {
+      IoUring ring(2);
+
+      // IORING_OP_READ arrived in 5.6, together with the opcode probe; an
+      // older kernel sets up rings but rejects the probe (and the reads)
+      constexpr unsigned max_ops = 256;
+      std::vector<uint8_t> storage(sizeof(io_uring_probe) + max_ops * sizeof(io_uring_probe_op), 0);
+      auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+      int ret = static_cast<int>(syscall(__NR_io_uring_register, ring.ring_fd_,
+                                         IORING_REGISTER_PROBE, probe, max_ops));
+      if (ret < 0) {
+        return false;
+      }
+      for (unsigned op : {IORING_OP_READ, IORING_OP_READ_FIXED}) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+          return false;
+        }
+      }
+      return true;
+    } catch (const std::system_error&) {
+      return false;
+    }
+  }();
+  return ok;
+}
+
+bool IoUring::register_buffers(const std::vector<iovec>& buffers) {
+  if (buffers.empty()) {
+    return false;
+  }
+  int ret = static_cast<int>(syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                                     buffers.data(), static_cast<unsigned>(buffers.size())));
+  if (ret < 0) {
+    return false;
+  }
+  registered_ = buffers;
+  return true;
+}
+
+void IoUring::prep_read(int fd, uint8_t* dst, unsigned len, uint64_t offset, uint64_t user_data) {
+  const unsigned tail = *sq_tail_;
+  const unsigned index = tail & *sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(dst);
+  sqe->len = len;
+  sqe->off = offset;
+  sqe->user_data = user_data;
+
+  // Use a pinned buffer when one covers the whole destination
+  for (size_t i = 0; i < registered_.size(); ++i) {
+    auto* base = static_cast<uint8_t*>(registered_[i].iov_base);
+    if (dst >= base && dst + len <= base + registered_[i].iov_len) {
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->buf_index = static_cast<uint16_t>(i);
+      break;
+    }
+  }
+
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++to_submit_;
+}
+
+void IoUring::enter(unsigned min_complete) {
+  const unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+  for (;;) {
+    int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit_,
+                                       min_complete, flags, nullptr, 0));
+    if (ret >= 0) {
+      to_submit_ -= static_cast<unsigned>(ret);
+      return;
+    }
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+    }
+  }
+}
+
+bool IoUring::reap(uint64_t& user_data, int32_t& res) {
+  const unsigned head = *cq_head_;
+  if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+
+  const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+  user_data = cqe.user_data;
+  res = cqe.res;
+  __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+size_t IoUring::read_range(int fd, uint8_t* dst, size_t len, uint64_t offset,
+                           size_t chunk_bytes, const ChunkCallback& on_chunk) {
+  // Reads are capped well below the 2GB per-request limit
+  chunk_bytes = std::clamp<size_t>(chunk_bytes, 1, size_t{1} << 30);
+  const size_t num_chunks = (len + chunk_bytes - 1) / chunk_bytes;
+  std::vector<size_t> progress(num_chunks, 0);
+
+  auto chunk_len = [&](size_t chunk) {
+    return std::min(chunk_bytes, len - chunk * chunk_bytes);
+  };
+  auto submit_rest = [&](size_t chunk) {
+    const size_t start = chunk * chunk_bytes + progress[chunk];
+    prep_read(fd, dst + start, static_cast<unsigned>(chunk_len(chunk) - progress[chunk]),
+              offset + start, chunk);
+  };
+
+  size_t next_chunk = 0;
+  size_t in_flight = 0;
+  size_t total = 0;
+  int error = 0;
+  std::exception_ptr callback_error;
+  std::exception_ptr enter_error;
+
+  // Once io_uring_enter fails, nothing more is submitted, but the reads
+  // already handed to the kernel still land in dst: keep waiting for them
+  auto wait = [&]() {
+    try {
+      enter(1);
+    } catch (...) {
+      if (!enter_error) {
+        enter_error = std::current_exception();
+      }
+      error = error == 0 ? ECANCELED : error;
+      // Requests still queued were never seen by the kernel; drop them
+      // (one per chunk in flight)
+      __atomic_store_n(sq_tail_, *sq_tail_ - to_submit_, __ATOMIC_RELEASE);
+      in_flight -= to_submit_;
+      to_submit_ = 0;
+    }
+  };
+
+  while (next_chunk < num_chunks || in_flight > 0) {
+    while (error == 0 && next_chunk < num_chunks && in_flight < entries_) {
+      submit_rest(next_chunk++);
+      ++in_flight;
+    }
+    if (error != 0 && in_flight == 0) {
+      break;
+    }
+
+    uint64_t chunk;
+    int32_t res;
+    if (!reap(chunk, res)) {
+      wait();
+      continue;
+    }
+
+    if (res < 0) {
+      if ((res == -EINTR || res == -EAGAIN) && error == 0) {
+        submit_rest(chunk);
+      } else {
+        --in_flight;
+        error = error == 0 ? -res : error;
+      }
+      continue;
+    }
+
+    progress[chunk] += static_cast<size_t>(res);
+    if (res > 0 && progress[chunk] < chunk_len(chunk) && error == 0) {
+      submit_rest(chunk); // Short read: fetch the remainder
+      continue;
+    }
+
+    // Chunk complete (or cut short by end of file)
+    --in_flight;
+    total += progress[chunk];
+    if (on_chunk && error == 0 && !callback_error) {
+      try {
+        on_chunk(chunk * chunk_bytes, progress[chunk]);
+      } catch (...) {
+        callback_error = std::current_exception();
+        error = ECANCELED;
+      }
+    }
+  }
+
+  // Every request has been reaped (each queued one counts as in flight),
+  // so nothing still writes into dst
+  if (callback_error) {
+    std::rethrow_exception(callback_error);
+  }
+  if (enter_error) {
+    std::rethrow_exception(enter_error);
+  }
+  if (error != 0) {
+    throw std::system_error(error, std::generic_category(), "io_uring read");
+  }
+  return total;
+}
+
+} // namespace databento
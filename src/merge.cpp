@@ -0,0 +1,105 @@
+#include "databento/merge.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace databento {
+
+// ============================================================================
+// MergedReader Implementation
+// ============================================================================
+
+MergedReader::MergedReader(const std::vector<std::string>& paths, RType schema)
+    : schema_(schema), record_size_(record_size_for(schema)) {
+  if (paths.empty()) {
+    throw std::invalid_argument("MergedReader needs at least one file");
+  }
+  sources_.reserve(paths.size());
+  for (const std::string& path : paths) {
+    auto parser = std::make_unique<DbnParser>(path, schema);
+    if (!parser->data()) {
+      parser->load_with_mmap();
+    }
+    total_records_ += parser->num_records();
+    sources_.push_back({std::move(parser), nullptr, nullptr});
+  }
+
+  leaves_ = std::bit_ceil(sources_.size());
+  keys_.assign(leaves_, UINT64_MAX);
+  done_.assign(leaves_, 1);
+  tree_.assign(leaves_, 0);
+  reset();
+}
+
+void MergedReader::load_key(uint32_t s) {
+  const Source& src = sources_[s];
+  if (src.cursor == src.end) {
+    keys_[s] = UINT64_MAX;
+    done_[s] = 1;
+  } else {
+    keys_[s] = read_u64_le(src.cursor + offsetof(MboMsg, ts_event));
+  }
+}
+
+void MergedReader::reset() {
+  for (uint32_t s = 0; s < sources_.size(); ++s) {
+    Source& src = sources_[s];
+    src.cursor = src.parser->data() + src.parser->metadata_offset();
+    src.end = src.cursor + src.parser->num_records() * record_size_;
+    done_[s] = 0;
+    load_key(s);
+  }
+  remaining_ = total_records_;
+  build_tree();
+}
+
+void MergedReader::build_tree() {
+  // Play the matches bottom-up: winners move on, losers stay at the node
+  std::vector<uint32_t> winners(2 * leaves_);
+  for (uint32_t s = 0; s < leaves_; ++s) {
+    winners[leaves_ + s] = s;
+  }
+  for (size_t node = leaves_ - 1; node >= 1; --node) {
+    const uint32_t a = winners[2 * node];
+    const uint32_t b = winners[2 * node + 1];
+    const bool a_wins = beats(a, b);
+    winners[node] = a_wins ? a : b;
+    tree_[node] = a_wins ? b : a;
+  }
+  winner_ = winners[1];
+}
+
+size_t MergedReader::next_batch(std::span<MergedRecord> out) {
+  const size_t n = std::min(out.size(), remaining_);
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t w = winner_;
+    Source& src = sources_[w];
+    out[i] = {src.cursor, w};
+    src.cursor += record_size_;
+    load_key(w);
+
+    // Replay the winner's path: at each node the stored loser plays the
+    // new candidate, and whichever loses stays behind
+    for (size_t node = (leaves_ + w) >> 1; node >= 1; node >>= 1) {
+      const uint32_t other = tree_[node];
+      if (beats(other, w)) {
+        tree_[node] = w;
+        w = other;
+      }
+    }
+    winner_ = w;
+  }
+  remaining_ -= n;
+  return n;
+}
+
+void MergedReader::parse_mbo(MboCallback callback) {
+  parse_mbo<MboCallback&>(callback);
+}
+
+void MergedReader::parse_trade(TradeCallback callback) {
+  parse_trade<TradeCallback&>(callback);
+}
+
+} // namespace databento
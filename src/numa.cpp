@@ -0,0 +1,161 @@
+#include "databento/numa.hpp"
+#include <algorithm>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace databento {
+
+namespace {
+
+// Parse a sysfs CPU list such as "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string& text) {
+  std::vector<int> cpus;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item.empty() || item == "\n") {
+      continue;
+    }
+    const size_t dash = item.find('-');
+    const int first = std::stoi(item.substr(0, dash));
+    const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+NumaTopology read_topology() {
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  const bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  const auto is_allowed = [&](int cpu) {
+    return !have_mask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+  };
+
+  NumaTopology topology;
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string nodes_text;
+  if (online && std::getline(online, nodes_text)) {
+    for (int node : parse_cpu_list(nodes_text)) {
+      std::ifstream list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      std::string cpus_text;
+      std::getline(list, cpus_text);
+      std::vector<int> cpus;
+      for (int cpu : parse_cpu_list(cpus_text)) {
+        if (is_allowed(cpu)) {
+          cpus.push_back(cpu);
+        }
+      }
+      // Memory-only nodes (CXL, HBM) have no CPUs to place workers on
+      if (!cpus.empty()) {
+        topology.node_cpus.push_back(std::move(cpus));
+        topology.node_ids.push_back(node);
+      }
+    }
+  }
+
+  if (topology.node_cpus.empty()) {
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (have_mask ? CPU_ISSET(cpu, &allowed) : cpu == 0) {
+        cpus.push_back(cpu);
+      }
+    }
+    topology.node_cpus.push_back(std::move(cpus));
+    topology.node_ids.push_back(0);
+  }
+  return topology;
+}
+
+} // namespace
+
+// ============================================================================
+// NumaTopology Implementation
+// ============================================================================
+
+size_t NumaTopology::num_cpus() const {
+  size_t total = 0;
+  for (const auto& cpus : node_cpus) {
+    total += cpus.size();
+  }
+  return total;
+}
+
+int NumaTopology::node_of_cpu(int cpu) const {
+  for (size_t node = 0; node < node_cpus.size(); ++node) {
+    if (std::find(node_cpus[node].begin(), node_cpus[node].end(), cpu) != node_cpus[node].end()) {
+      return node_ids[node];
+    }
+  }
+  return -1;
+}
+
+int NumaTopology::cpu_for_worker(size_t worker, size_t num_workers) const {
+  const size_t total = num_cpus();
+  if (total == 0 || num_workers == 0) {
+    return -1;
+  }
+  // More workers than CPUs wrap around; fewer are spread evenly
+  size_t index = num_workers <= total ? worker * total / num_workers : worker % total;
+  for (const auto& cpus : node_cpus) {
+    if (index < cpus.size()) {
+      return cpus[index];
+    }
+    index -= cpus.size();
+  }
+  return -1;
+}
+
+const NumaTopology& NumaTopology::system() {
+  static const NumaTopology topology = read_topology();
+  return topology;
+}
+
+// ============================================================================
+// Placement
+// ============================================================================
+
+bool pin_current_thread(int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+bool interleave_pages(void* addr, size_t len, const NumaTopology& topology) {
+  if (topology.num_nodes() < 2) {
+    return false;
+  }
+
+  // Interleave over every node with memory, by kernel node id
+  std::ifstream has_memory("/sys/devices/system/node/has_memory");
+  std::string nodes_text;
+  std::getline(has_memory, nodes_text);
+  unsigned long mask[16] = {};
+  constexpr size_t max_node = sizeof(mask) * 8;
+  for (int node : parse_cpu_list(nodes_text)) {
+    if (node >= 0 && static_cast<size_t>(node) < max_node) {
+      mask[node / 64] |= 1UL << (node % 64);
+    }
+  }
+
+  const long page = sysconf(_SC_PAGESIZE);
+  const auto start = (reinterpret_cast<uintptr_t>(addr) + page - 1) & ~(uintptr_t(page) - 1);
+  const auto end = (reinterpret_cast<uintptr_t>(addr) + len) & ~(uintptr_t(page) - 1);
+  if (end <= start) {
+    return false;
+  }
+  return syscall(SYS_mbind, start, end - start, MPOL_INTERLEAVE, mask, max_node, 0) == 0;
+}
+
+} // namespace databento
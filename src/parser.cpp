@@ -1,9 +1,15 @@
 #include "databento/parser.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <chrono>
 #include <stdexcept>
 #include <cstring>
+#include <exception>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -15,16 +21,28 @@ namespace databento {
 // DbnParser Implementation
 // ============================================================================
 
-DbnParser::DbnParser(const std::string& filepath)
+DbnParser::DbnParser(const std::string& filepath, RType schema)
     : filepath_(filepath),
       data_(nullptr),
       size_(0),
       metadata_offset_(200),  // Standard DBN metadata size
-      record_size_(48),       // MBO/Trade record size
+      schema_(schema),
+      record_size_(record_size_for(schema)),
       num_records_(0),
       mmap_addr_(nullptr),
+      mmap_len_(0),
       mmap_fd_(-1),
-      using_mmap_(false) {
+      using_mmap_(false),
+      io_backend_(IoBackend::None),
+      huge_pages_(HugePages::Off),
+      mmap_backing_(PageBacking::Small),
+      mmap_window_(0),
+      window_pos_(SIZE_MAX),
+      window_ahead_(0),
+      window_dropped_(0) {
+  if (record_size_ == 0) {
+    throw std::invalid_argument("Unsupported schema for DbnParser");
+  }
 }
 
 DbnParser::~DbnParser() {
@@ -34,7 +52,7 @@ DbnParser::~DbnParser() {
 
 void DbnParser::cleanup_mmap() {
   if (using_mmap_ && mmap_addr_ != nullptr && mmap_addr_ != MAP_FAILED) {
-    munmap(mmap_addr_, size_);
+    munmap(mmap_addr_, mmap_len_);
     mmap_addr_ = nullptr;
   }
   
@@ -46,7 +64,32 @@ void DbnParser::cleanup_mmap() {
   using_mmap_ = false;
 }
 
+// The previous load's data is released or about to be overwritten; until
+// the new load completes, nothing may still describe it
+void DbnParser::reset_loaded() {
+  data_ = nullptr;
+  num_records_ = 0;
+  io_backend_ = IoBackend::None;
+}
+
+PageBacking DbnParser::page_backing() const {
+  return using_mmap_ ? mmap_backing_ : buffer_.backing();
+}
+
+// Size buffer_ for a fresh load, reallocating if the huge page mode changed
+uint8_t* DbnParser::prepare_buffer(size_t bytes) {
+  if (buffer_.huge_pages() != huge_pages_) {
+    buffer_ = AlignedBuffer<uint8_t>(huge_pages_);
+  }
+  buffer_.resize(bytes);
+  return buffer_.data();
+}
+
 void DbnParser::load_into_memory() {
+  if (load_if_compressed()) {
+    return;
+  }
+
   std::ifstream file(filepath_, std::ios::binary | std::ios::ate);
   if (!file) {
     throw std::runtime_error("Failed to open file: " + filepath_);
@@ -55,7 +98,12 @@ void DbnParser::load_into_memory() {
   size_ = file.tellg();
   file.seekg(0, std::ios::beg);
 
-  buffer_.resize(size_);
+  cleanup_mmap();
+  numa_placement_.clear();
+  time_index_.reset();
+  instrument_index_.reset();
+  reset_loaded();
+  prepare_buffer(size_);
   file.read(reinterpret_cast<char*>(buffer_.data()), size_);
   
   if (!file) {
@@ -66,6 +114,7 @@ void DbnParser::load_into_memory() {
 
   data_ = buffer_.data();
   using_mmap_ = false;
+  io_backend_ = IoBackend::Ifstream;
 
   // Calculate number of records
   if (size_ > metadata_offset_) {
@@ -77,6 +126,14 @@ void DbnParser::load_into_memory() {
 void DbnParser::load_with_mmap() {
   // Clean up any existing mapping
   cleanup_mmap();
+  numa_placement_.clear();
+  time_index_.reset();
+  instrument_index_.reset();
+  reset_loaded();
+
+  if (load_if_compressed()) {
+    return;
+  }
   
   // Open file
   mmap_fd_ = open(filepath_.c_str(), O_RDONLY);
@@ -94,19 +151,43 @@ void DbnParser::load_with_mmap() {
   
   size_ = sb.st_size;
   
-  // Memory map the file
-  mmap_addr_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, mmap_fd_, 0);
+  // Memory map the file. For huge pages, map it over a 2MB-aligned
+  // reservation so file offsets and huge page boundaries line up.
+  mmap_backing_ = PageBacking::Small;
+  if (huge_pages_ != HugePages::Off && size_ > 0) {
+    const PageAllocation reservation = allocate_pages(size_, HugePages::Off);
+    mmap_len_ = reservation.bytes;
+    mmap_addr_ = mmap(reservation.addr, size_, PROT_READ, MAP_PRIVATE | MAP_FIXED, mmap_fd_, 0);
+    if (mmap_addr_ == MAP_FAILED) {
+      free_pages(reservation);
+    } else if (madvise(mmap_addr_, size_, MADV_HUGEPAGE) == 0) {
+      mmap_backing_ = PageBacking::Transparent;
+    }
+  } else {
+    mmap_len_ = size_;
+    mmap_addr_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, mmap_fd_, 0);
+  }
   if (mmap_addr_ == MAP_FAILED) {
+    mmap_addr_ = nullptr;
     close(mmap_fd_);
     mmap_fd_ = -1;
     throw std::runtime_error("Failed to mmap file: " + filepath_);
   }
   
-  // Advise kernel about access pattern
-  madvise(mmap_addr_, size_, MADV_SEQUENTIAL | MADV_WILLNEED);
+  // Advise kernel about access pattern. A windowed scan prefetches as it
+  // goes instead of pulling in the whole file, so faults read only their
+  // page: fault readahead (up to the device's read_ahead_kb) would run past
+  // the window, and time-index probes would pull in megabytes mid-file.
+  window_pos_ = SIZE_MAX;
+  if (mmap_window_ > 0) {
+    madvise(mmap_addr_, size_, MADV_RANDOM);
+  } else {
+    madvise(mmap_addr_, size_, MADV_SEQUENTIAL | MADV_WILLNEED);
+  }
   
   data_ = static_cast<const uint8_t*>(mmap_addr_);
   using_mmap_ = true;
+  io_backend_ = IoBackend::Mmap;
   
   // Calculate number of records
   if (size_ > metadata_offset_) {
@@ -115,31 +196,475 @@ void DbnParser::load_with_mmap() {
   }
 }
 
-void DbnParser::parse_mbo(MboCallback callback) {
-  if (!data_) {
-    load_into_memory();
+void DbnParser::slide_mmap_window(size_t offset) {
+  const size_t step = std::max<size_t>(mmap_window_ / 2, 1);
+  if (offset >= window_pos_ && offset - window_pos_ < step) {
+    return;
+  }
+
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t page_start = std::min(offset, size_) & ~(page - 1);
+  auto* base = static_cast<uint8_t*>(mmap_addr_);
+  if (offset < window_pos_) {
+    // First step, or a new scan from further back
+    window_ahead_ = page_start;
+    window_dropped_ = page_start;
   }
+  window_pos_ = offset;
 
-  const uint8_t* ptr = data_ + metadata_offset_;
-  for (size_t i = 0; i < num_records_; ++i) {
-    MboMsg msg;
-    std::memcpy(&msg, ptr, sizeof(MboMsg));
-    callback(msg);
-    ptr += record_size_;
+  // Ahead: start readahead on the part of the next window not yet advised
+  const size_t ahead_end = std::min(offset + mmap_window_, size_);
+  if (ahead_end > window_ahead_) {
+    madvise(base + window_ahead_, ahead_end - window_ahead_, MADV_WILLNEED);
+    window_ahead_ = ahead_end;
+  }
+
+  // Behind: the scan is done with every page before the cursor's. Unmap
+  // them from this process, then drop them from the page cache. The cache
+  // may hold the file in large folios (up to HUGE_PAGE_SIZE) and only drops
+  // those wholly inside the range, so start that far back to catch the
+  // folio that straddled the last boundary.
+  if (page_start > window_dropped_) {
+    madvise(base + window_dropped_, page_start - window_dropped_, MADV_DONTNEED);
+    const size_t evict_from = window_dropped_ > HUGE_PAGE_SIZE ? window_dropped_ - HUGE_PAGE_SIZE : 0;
+    posix_fadvise(mmap_fd_, static_cast<off_t>(evict_from),
+                  static_cast<off_t>(page_start - evict_from), POSIX_FADV_DONTNEED);
+    window_dropped_ = page_start;
   }
 }
 
-void DbnParser::parse_trade(TradeCallback callback) {
-  if (!data_) {
-    load_into_memory();
+size_t DbnParser::resident_bytes() const {
+  if (data_ == nullptr || size_ == 0) {
+    return 0;
+  }
+  const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(data_) & ~(page - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(data_) + size_;
+  std::vector<unsigned char> pages((end - begin + page - 1) / page);
+  if (mincore(reinterpret_cast<void*>(begin), end - begin, pages.data()) != 0) {
+    return 0;
+  }
+  const size_t resident =
+      std::count_if(pages.begin(), pages.end(), [](unsigned char p) { return p & 1; });
+  return std::min(resident * page, size_);
+}
+
+void DbnParser::load_zstd(size_t num_threads) {
+  cleanup_mmap();
+  numa_placement_.clear();
+  time_index_.reset();
+  instrument_index_.reset();
+  reset_loaded();
+
+  ZstdDecoder decoder(filepath_, num_threads);
+  // The frame headers' total is only trusted up to a plausible ratio; a
+  // corrupt size falls through to the grow path below
+  prepare_buffer(static_cast<size_t>(std::min<uint64_t>(
+      decoder.content_size(), ZSTD_PREALLOC_RATIO * decoder.compressed_size())));
+
+  size_t used = 0;
+  ZstdDecoder::Block block;
+  while (decoder.next(block)) {
+    if (used + block.size > buffer_.size()) {
+      // Content size unknown or wrong: grow geometrically, keeping the bytes
+      AlignedBuffer<uint8_t> grown(huge_pages_);
+      grown.resize(std::max(2 * buffer_.size(), used + block.size));
+      if (used > 0) {
+        std::memcpy(grown.data(), buffer_.data(), used);
+      }
+      buffer_ = std::move(grown);
+    }
+    std::memcpy(buffer_.data() + used, block.data(), block.size);
+    used += block.size;
   }
 
-  const uint8_t* ptr = data_ + metadata_offset_;
-  for (size_t i = 0; i < num_records_; ++i) {
-    TradeMsg msg;
-    std::memcpy(&msg, ptr, sizeof(TradeMsg));
-    callback(msg);
-    ptr += record_size_;
+  size_ = used;
+  data_ = buffer_.data();
+  using_mmap_ = false;
+  io_backend_ = IoBackend::Zstd;
+  num_records_ = size_ > metadata_offset_ ? (size_ - metadata_offset_) / record_size_ : 0;
+}
+
+bool DbnParser::load_if_compressed() {
+  if (!is_zstd_file(filepath_)) {
+    return false;
+  }
+  load_zstd();
+  return true;
+}
+
+namespace {
+
+// Reports whole records, in file order, as the loaded prefix of the file
+// grows. Chunk k ends at base + (k + 1) * chunk_bytes (the first chunk also
+// holds the base bytes). Chunks may complete in any order.
+class RecordsReadyTracker {
+public:
+  RecordsReadyTracker(size_t chunk_bytes, size_t size, size_t metadata_offset,
+                      size_t record_size, size_t num_records,
+                      const RecordsReadyCallback& on_records, size_t base = 0)
+      : chunk_bytes_(chunk_bytes),
+        base_(base),
+        size_(size),
+        metadata_offset_(metadata_offset),
+        record_size_(record_size),
+        num_records_(num_records),
+        on_records_(on_records),
+        done_(num_chunks(chunk_bytes, size, base), 0),
+        prefix_chunks_(0),
+        emitted_(0) {}
+
+  static size_t num_chunks(size_t chunk_bytes, size_t size, size_t base) {
+    const size_t body = size > base ? size - base : 0;
+    const size_t chunks = (body + chunk_bytes - 1) / chunk_bytes;
+    return chunks == 0 && size > 0 ? 1 : chunks;
+  }
+
+  void chunk_done(size_t chunk) {
+    done_[chunk] = 1;
+    while (prefix_chunks_ < done_.size() && done_[prefix_chunks_]) {
+      ++prefix_chunks_;
+    }
+
+    const size_t loaded =
+        prefix_chunks_ > 0 ? std::min(size_, base_ + prefix_chunks_ * chunk_bytes_) : 0;
+    const size_t ready = loaded > metadata_offset_
+        ? std::min(num_records_, (loaded - metadata_offset_) / record_size_)
+        : 0;
+    if (ready > emitted_ && on_records_) {
+      on_records_({emitted_, ready});
+    }
+    emitted_ = std::max(emitted_, ready);
+  }
+
+private:
+  size_t chunk_bytes_;
+  size_t base_;
+  size_t size_;
+  size_t metadata_offset_;
+  size_t record_size_;
+  size_t num_records_;
+  const RecordsReadyCallback& on_records_;
+  std::vector<uint8_t> done_;
+  size_t prefix_chunks_;
+  size_t emitted_;
+};
+
+} // namespace
+
+void DbnParser::load_with_io_uring(size_t queue_depth, size_t chunk_bytes,
+                                   const RecordsReadyCallback& on_records) {
+  cleanup_mmap();
+  numa_placement_.clear();
+  time_index_.reset();
+  instrument_index_.reset();
+  reset_loaded();
+
+  if (load_if_compressed()) {
+    if (on_records && num_records_ > 0) {
+      on_records({0, num_records_});
+    }
+    return;
+  }
+
+  int fd = open(filepath_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filepath_);
+  }
+
+  struct stat sb;
+  if (fstat(fd, &sb) < 0) {
+    close(fd);
+    throw std::runtime_error("Failed to get file size: " + filepath_);
+  }
+
+  size_ = sb.st_size;
+  data_ = prepare_buffer(size_);
+  num_records_ = size_ > metadata_offset_ ? (size_ - metadata_offset_) / record_size_ : 0;
+
+  chunk_bytes = std::max<size_t>(chunk_bytes, 4096);
+  RecordsReadyTracker tracker(chunk_bytes, size_, metadata_offset_, record_size_,
+                              num_records_, on_records);
+
+  try {
+    size_t loaded = 0;
+    if (IoUring::supported()) {
+      IoUring ring(static_cast<unsigned>(queue_depth));
+
+      // Pin the destination in 1GB pieces (the per-buffer kernel limit);
+      // chunks straddling a piece fall back to unregistered reads
+      constexpr size_t max_registered = size_t{1} << 30;
+      std::vector<iovec> pieces;
+      for (size_t off = 0; off < size_; off += max_registered) {
+        pieces.push_back({buffer_.data() + off, std::min(max_registered, size_ - off)});
+      }
+      ring.register_buffers(pieces);
+
+      // A chunk cut short by end of file (the file shrank) is not done:
+      // its records would cover bytes never read
+      loaded = ring.read_range(fd, buffer_.data(), size_, 0, chunk_bytes,
+                               [&](size_t offset, size_t len) {
+                                 if (len == std::min(chunk_bytes, size_ - offset)) {
+                                   tracker.chunk_done(offset / chunk_bytes);
+                                 }
+                               });
+      io_backend_ = IoBackend::IoUring;
+    } else {
+      for (size_t off = 0; off < size_; off += chunk_bytes) {
+        const size_t len = std::min(chunk_bytes, size_ - off);
+        const size_t got = pread_fully(fd, buffer_.data() + off, len, off);
+        loaded += got;
+        if (got != len) {
+          break;
+        }
+        tracker.chunk_done(off / chunk_bytes);
+      }
+      io_backend_ = IoBackend::Pread;
+    }
+
+    if (loaded != size_) {
+      throw std::runtime_error("Failed to read file: " + filepath_);
+    }
+  } catch (...) {
+    close(fd);
+    data_ = nullptr;
+    num_records_ = 0;
+    io_backend_ = IoBackend::None;
+    throw;
+  }
+
+  close(fd);
+}
+
+void DbnParser::load_parallel(size_t num_threads, size_t chunk_bytes,
+                              const RecordsReadyCallback& on_records) {
+  cleanup_mmap();
+  numa_placement_.clear();
+  time_index_.reset();
+  instrument_index_.reset();
+  reset_loaded();
+
+  if (load_if_compressed()) {
+    if (on_records && num_records_ > 0) {
+      on_records({0, num_records_});
+    }
+    return;
+  }
+
+  int fd = open(filepath_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filepath_);
+  }
+
+  struct stat sb;
+  if (fstat(fd, &sb) < 0) {
+    close(fd);
+    throw std::runtime_error("Failed to get file size: " + filepath_);
+  }
+
+  size_ = sb.st_size;
+  num_records_ = size_ > metadata_offset_ ? (size_ - metadata_offset_) / record_size_ : 0;
+  uint8_t* dst = prepare_buffer(size_);
+  data_ = dst; // on_records may read records that have landed
+  using_mmap_ = false;
+
+  // Chunk boundaries fall on whole records, so a completed chunk is
+  // parseable on its own; the first chunk also carries the metadata
+  const size_t chunk_records = std::max<size_t>(1, chunk_bytes / record_size_);
+  const size_t aligned_bytes = chunk_records * record_size_;
+  const size_t num_chunks =
+      RecordsReadyTracker::num_chunks(aligned_bytes, size_, metadata_offset_);
+  RecordsReadyTracker tracker(aligned_bytes, size_, metadata_offset_, record_size_, num_records_,
+                              on_records, metadata_offset_);
+
+  const size_t workers =
+      std::max<size_t>(1, std::min(resolve_thread_count(num_threads), num_chunks));
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> stop{false};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<size_t> finished;
+  size_t workers_done = 0;
+  std::vector<std::exception_ptr> errors(workers);
+  std::vector<std::thread> threads;
+  threads.reserve(workers);
+
+  const auto worker = [&](size_t t) {
+    try {
+      while (!stop.load(std::memory_order_relaxed)) {
+        const size_t k = next_chunk.fetch_add(1);
+        if (k >= num_chunks) {
+          break;
+        }
+        const size_t lo = k == 0 ? 0 : metadata_offset_ + k * aligned_bytes;
+        const size_t hi = std::min(size_, metadata_offset_ + (k + 1) * aligned_bytes);
+        if (pread_fully(fd, dst + lo, hi - lo, static_cast<off_t>(lo)) != hi - lo) {
+          throw std::runtime_error("Failed to read file: " + filepath_);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(k);
+        cv.notify_one();
+      }
+    } catch (...) {
+      errors[t] = std::current_exception();
+      stop.store(true);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    ++workers_done;
+    cv.notify_one();
+  };
+
+  const auto fail = [&]() {
+    stop.store(true);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    close(fd);
+    data_ = nullptr;
+    num_records_ = 0;
+    io_backend_ = IoBackend::None;
+  };
+
+  try {
+    for (size_t t = 0; t < workers; ++t) {
+      threads.emplace_back(worker, t);
+    }
+
+    // Report chunks on the calling thread, in file order, as they land
+    std::vector<size_t> ready;
+    for (bool all_done = false; !all_done;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return !finished.empty() || workers_done == workers; });
+        ready.swap(finished);
+        all_done = workers_done == workers && finished.empty();
+      }
+      for (size_t k : ready) {
+        tracker.chunk_done(k);
+      }
+      ready.clear();
+    }
+  } catch (...) {
+    fail();
+    throw;
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      fail();
+      std::rethrow_exception(error);
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  close(fd);
+  io_backend_ = IoBackend::Pread;
+}
+
+void DbnParser::load_numa(size_t num_threads, bool interleave) {
+  cleanup_mmap();
+  numa_placement_.clear();
+  time_index_.reset();
+  instrument_index_.reset();
+  reset_loaded();
+
+  if (load_if_compressed()) {
+    return;
+  }
+
+  int fd = open(filepath_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filepath_);
+  }
+
+  struct stat sb;
+  if (fstat(fd, &sb) < 0) {
+    close(fd);
+    throw std::runtime_error("Failed to get file size: " + filepath_);
+  }
+
+  size_ = sb.st_size;
+  num_records_ = size_ > metadata_offset_ ? (size_ - metadata_offset_) / record_size_ : 0;
+
+  // Fresh, untouched pages: reusing the old buffer would keep its placement
+  buffer_ = AlignedBuffer<uint8_t>(huge_pages_);
+  uint8_t* dst = prepare_buffer(size_);
+
+  const NumaTopology& topology = NumaTopology::system();
+  if (interleave) {
+    interleave_pages(dst, size_, topology);
+  }
+
+  const std::vector<RecordRange> ranges = partition(resolve_thread_count(num_threads));
+  std::vector<NumaPlacement> placement;
+  placement.reserve(ranges.size());
+  for (size_t t = 0; t < ranges.size(); ++t) {
+    const int cpu = topology.cpu_for_worker(t, ranges.size());
+    placement.push_back({ranges[t], cpu, topology.node_of_cpu(cpu)});
+  }
+
+  // Worker t reads its records' bytes; the first also takes the metadata
+  // and the last any trailing partial record
+  std::vector<std::exception_ptr> errors(ranges.size());
+  std::vector<std::thread> threads;
+  threads.reserve(ranges.size());
+  for (size_t t = 0; t < ranges.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      try {
+        pin_current_thread(placement[t].cpu);
+        const size_t begin = metadata_offset_ + ranges[t].begin * record_size_;
+        const size_t end = metadata_offset_ + ranges[t].end * record_size_;
+        const size_t lo = t == 0 ? 0 : std::min(size_, begin);
+        const size_t hi = t + 1 == ranges.size() ? size_ : std::min(size_, end);
+        if (hi > lo && pread_fully(fd, dst + lo, hi - lo, static_cast<off_t>(lo)) != hi - lo) {
+          throw std::runtime_error("Failed to read file: " + filepath_);
+        }
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  close(fd);
+
+  for (const auto& error : errors) {
+    if (error) {
+      data_ = nullptr;
+      num_records_ = 0;
+      io_backend_ = IoBackend::None;
+      std::rethrow_exception(error);
+    }
+  }
+
+  data_ = dst;
+  using_mmap_ = false;
+  io_backend_ = IoBackend::Pread;
+  numa_placement_ = std::move(placement);
+}
+
+void DbnParser::parse_mbo(MboCallback callback) {
+  parse_mbo<MboCallback&>(callback);
+}
+
+void DbnParser::parse_trade(TradeCallback callback) {
+  parse_trade<TradeCallback&>(callback);
+}
+
+void DbnParser::parse_mbp1(Mbp1Callback callback) {
+  parse_mbp1<Mbp1Callback&>(callback);
+}
+
+void DbnParser::parse_mbp10(Mbp10Callback callback) {
+  parse_mbp10<Mbp10Callback&>(callback);
+}
+
+void DbnParser::check_record_type(size_t record_bytes) const {
+  if (record_bytes > record_size_) {
+    throw std::runtime_error("Record type is larger than this parser's records: " + filepath_);
   }
 }
 
@@ -157,18 +682,273 @@ const uint8_t* DbnParser::get_batch(size_t start_index, size_t count) const {
   return data_ + metadata_offset_ + (start_index * record_size_);
 }
 
+size_t DbnParser::resolve_thread_count(size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  return num_threads == 0 ? 1 : num_threads;
+}
+
+std::vector<RecordRange> DbnParser::partition(size_t num_parts) const {
+  num_parts = num_parts == 0 ? 1 : num_parts;
+
+  const size_t chunks = (num_records_ + PARALLEL_CHUNK_RECORDS - 1) / PARALLEL_CHUNK_RECORDS;
+  std::vector<RecordRange> ranges;
+  ranges.reserve(num_parts);
+
+  for (size_t p = 0; p < num_parts; ++p) {
+    const size_t begin = std::min(num_records_, (chunks * p / num_parts) * PARALLEL_CHUNK_RECORDS);
+    const size_t end = std::min(num_records_, (chunks * (p + 1) / num_parts) * PARALLEL_CHUNK_RECORDS);
+    ranges.push_back({begin, end});
+  }
+  return ranges;
+}
+
+void DbnParser::parallel_for_ranges(
+    size_t num_threads,
+    const std::function<void(size_t, RecordRange)>& fn) {
+  if (!data_) {
+    load_into_memory();
+  }
+
+  const std::vector<RecordRange> ranges = partition(resolve_thread_count(num_threads));
+  if (ranges.size() == 1) {
+    fn(0, ranges[0]);
+    return;
+  }
+
+  const bool pinned = numa_placement_.size() == ranges.size();
+  std::vector<std::exception_ptr> errors(ranges.size());
+  std::vector<std::thread> threads;
+  threads.reserve(ranges.size());
+
+  for (size_t t = 0; t < ranges.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      try {
+        if (pinned) {
+          pin_current_thread(numa_placement_[t].cpu);
+        }
+        fn(t, ranges[t]);
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+// ============================================================================
+// Time-Range Queries
+// ============================================================================
+
+void DbnParser::load_for_seek() {
+  if (!data_) {
+    load_with_mmap();
+  }
+}
+
+size_t DbnParser::lower_bound_time(uint64_t ts) {
+  load_for_seek();
+  if (time_index_) {
+    return indexed_lower_bound(ts);
+  }
+  return lower_bound_ts(data_ + metadata_offset_, num_records_, record_size_, ts);
+}
+
+size_t DbnParser::indexed_lower_bound(uint64_t ts) const {
+  const TimeIndex& index = *time_index_;
+  const uint8_t* records = data_ + metadata_offset_;
+
+  // First block that can hold a record >= ts; max_ts only ascends if sorted
+  size_t block;
+  if (index.sorted) {
+    block = std::lower_bound(index.max_ts.begin(), index.max_ts.end(), ts) - index.max_ts.begin();
+  } else {
+    block = std::find_if(index.max_ts.begin(), index.max_ts.end(),
+                         [ts](uint64_t max) { return max >= ts; }) - index.max_ts.begin();
+  }
+  if (block == index.num_blocks()) {
+    return num_records_;
+  }
+
+  const size_t begin = block * index.block_records;
+  const size_t count = std::min(index.block_records, num_records_ - begin);
+  const uint8_t* base = records + begin * record_size_;
+  if (index.sorted) {
+    return begin + lower_bound_ts(base, count, record_size_, ts);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (read_u64_le(base + i * record_size_ + offsetof(MboMsg, ts_event)) >= ts) {
+      return begin + i;
+    }
+  }
+  return begin + count; // Unreachable: the block's max is >= ts
+}
+
+std::vector<TimeSegment> DbnParser::time_segments(uint64_t t0, uint64_t t1) {
+  load_for_seek();
+  std::vector<TimeSegment> segments;
+  if (t0 >= t1) {
+    return segments;
+  }
+
+  if (!time_index_ || time_index_->sorted) {
+    const size_t begin = lower_bound_time(t0);
+    const size_t end = lower_bound_time(t1);
+    if (begin < end) {
+      segments.push_back({{begin, end}, true});
+    }
+    return segments;
+  }
+
+  // Unsorted: keep blocks whose bounds overlap the window, merging
+  // neighbours of the same kind
+  const TimeIndex& index = *time_index_;
+  for (size_t b = 0; b < index.num_blocks(); ++b) {
+    if (index.max_ts[b] < t0 || index.min_ts[b] >= t1) {
+      continue;
+    }
+    const bool exact = index.min_ts[b] >= t0 && index.max_ts[b] < t1;
+    const size_t begin = b * index.block_records;
+    const size_t end = std::min(begin + index.block_records, num_records_);
+    if (!segments.empty() && segments.back().range.end == begin && segments.back().exact == exact) {
+      segments.back().range.end = end;
+    } else {
+      segments.push_back({{begin, end}, exact});
+    }
+  }
+  return segments;
+}
+
+void DbnParser::parse_mbo_range(uint64_t t0, uint64_t t1, MboCallback callback) {
+  parse_mbo_range<MboCallback&>(t0, t1, callback);
+}
+
+void DbnParser::parse_trade_range(uint64_t t0, uint64_t t1, TradeCallback callback) {
+  parse_trade_range<TradeCallback&>(t0, t1, callback);
+}
+
+const TimeIndex& DbnParser::build_time_index(size_t block_records) {
+  load_for_seek();
+  if (!time_index_ || time_index_->block_records != block_records) {
+    time_index_ = std::make_unique<TimeIndex>(
+        TimeIndex::build(data_ + metadata_offset_, num_records_, record_size_, block_records));
+  }
+  return *time_index_;
+}
+
+// ============================================================================
+// Per-Instrument Scans
+// ============================================================================
+
+const InstrumentIndex& DbnParser::instrument_index(bool persist) {
+  load_for_seek();
+  if (instrument_index_) {
+    return *instrument_index_;
+  }
+
+  struct stat sb;
+  if (stat(filepath_.c_str(), &sb) < 0) {
+    throw std::runtime_error("Failed to get file size: " + filepath_);
+  }
+  const uint64_t source_size = sb.st_size;
+  const int64_t source_mtime_ns = static_cast<int64_t>(sb.st_mtim.tv_sec) * 1'000'000'000 +
+                                  sb.st_mtim.tv_nsec;
+  const std::string sidecar = InstrumentIndex::sidecar_path(filepath_);
+
+  auto loaded = InstrumentIndex::load(sidecar, source_size, source_mtime_ns, num_records_);
+  if (loaded) {
+    instrument_index_ = std::make_unique<InstrumentIndex>(std::move(*loaded));
+    return *instrument_index_;
+  }
+
+  instrument_index_ = std::make_unique<InstrumentIndex>(
+      InstrumentIndex::build(data_ + metadata_offset_, num_records_, record_size_));
+  if (persist) {
+    try {
+      instrument_index_->save(sidecar, source_size, source_mtime_ns);
+    } catch (const std::runtime_error&) {
+      // The in-memory index still serves this parser
+    }
+  }
+  return *instrument_index_;
+}
+
+void DbnParser::parse_mbo_instrument(uint32_t instrument_id, MboCallback callback) {
+  parse_mbo_instrument<MboCallback&>(instrument_id, callback);
+}
+
+void DbnParser::parse_trade_instrument(uint32_t instrument_id, TradeCallback callback) {
+  parse_trade_instrument<TradeCallback&>(instrument_id, callback);
+}
+
 // ============================================================================
 // ParseStats Implementation
 // ============================================================================
 
+namespace {
+
+void print_counters(const char* phase, const PerfSample& sample, uint64_t records,
+                    uint64_t bytes) {
+  if (!sample.valid()) {
+    return;
+  }
+  std::cout << phase << " counters:\n";
+  const auto line = [](const char* name, const std::optional<uint64_t>& value) {
+    std::cout << "  " << name;
+    if (value) {
+      std::cout << *value << "\n";
+    } else {
+      std::cout << "n/a\n";
+    }
+  };
+  line("Cycles:          ", sample.cycles);
+  line("Instructions:    ", sample.instructions);
+  line("LLC misses:      ", sample.llc_misses);
+  line("dTLB misses:     ", sample.dtlb_misses);
+  line("Branch misses:   ", sample.branch_misses);
+  if (sample.instructions && sample.cycles) {
+    std::cout << "  IPC:             " << sample.ipc() << "\n";
+  }
+  if (sample.cycles && *sample.cycles > 0 && records > 0) {
+    std::cout << "  Cycles/record:   " << static_cast<double>(*sample.cycles) / records << "\n";
+    std::cout << "  Bytes/cycle:     " << static_cast<double>(bytes) / *sample.cycles << "\n";
+  }
+}
+
+} // namespace
+
 void ParseStats::print() const {
   std::cout << "\n" << std::string(70, '=') << "\n";
   std::cout << "Parse Statistics\n";
   std::cout << std::string(70, '=') << "\n";
   std::cout << "Total records:  " << total_records << "\n";
+  std::cout << "Total bytes:    " << total_bytes << "\n";
   std::cout << "Elapsed time:   " << elapsed_seconds << " seconds\n";
+  std::cout << "  Load:         " << load_seconds << " seconds\n";
+  std::cout << "  Parse:        " << parse_seconds << " seconds\n";
   std::cout << "Records/sec:    " << static_cast<uint64_t>(records_per_second) << " rec/s\n";
   std::cout << "Throughput:     " << throughput_gbps << " GB/s\n";
+  std::cout << "Pages:          " << page_backing_name(page_backing);
+  if (huge_page_bytes > 0) {
+    std::cout << " (" << huge_page_bytes / (1024 * 1024) << " MB on huge pages)";
+  }
+  std::cout << "\n";
+  if (mmap_window_bytes > 0) {
+    std::cout << "Mmap window:    " << mmap_window_bytes / (1024 * 1024) << " MB ("
+              << resident_bytes / (1024 * 1024) << " MB resident after parse)\n";
+  }
+  print_counters("Load", load_counters, total_records, total_bytes);
+  print_counters("Parse", parse_counters, total_records, total_bytes);
   std::cout << std::string(70, '=') << "\n";
 }
 
@@ -176,42 +956,15 @@ void ParseStats::print() const {
 // High-Level Utility Functions
 // ============================================================================
 
-ParseStats parse_file_mbo(const std::string& filepath, MboCallback callback) {
-  auto start = std::chrono::high_resolution_clock::now();
-
-  DbnParser parser(filepath);
-  parser.load_into_memory();
-  parser.parse_mbo(callback);
-
-  auto end = std::chrono::high_resolution_clock::now();
-  double elapsed = std::chrono::duration<double>(end - start).count();
-
-  ParseStats stats;
-  stats.total_records = parser.num_records();
-  stats.elapsed_seconds = elapsed;
-  stats.records_per_second = stats.total_records / elapsed;
-  stats.throughput_gbps = (stats.total_records * 48.0) / (elapsed * 1024 * 1024 * 1024);
-
-  return stats;
+ParseStats parse_file_mbo(const std::string& filepath, MboCallback callback, bool hw_counters,
+                          HugePages huge_pages, size_t mmap_window) {
+  return parse_file_mbo<MboCallback&>(filepath, callback, hw_counters, huge_pages, mmap_window);
 }
 
-ParseStats parse_file_trade(const std::string& filepath, TradeCallback callback) {
-  auto start = std::chrono::high_resolution_clock::now();
-
-  DbnParser parser(filepath);
-  parser.load_into_memory();
-  parser.parse_trade(callback);
-
-  auto end = std::chrono::high_resolution_clock::now();
-  double elapsed = std::chrono::duration<double>(end - start).count();
-
-  ParseStats stats;
-  stats.total_records = parser.num_records();
-  stats.elapsed_seconds = elapsed;
-  stats.records_per_second = stats.total_records / elapsed;
-  stats.throughput_gbps = (stats.total_records * 48.0) / (elapsed * 1024 * 1024 * 1024);
-
-  return stats;
+ParseStats parse_file_trade(const std::string& filepath, TradeCallback callback,
+                            bool hw_counters, HugePages huge_pages, size_t mmap_window) {
+  return parse_file_trade<TradeCallback&>(filepath, callback, hw_counters, huge_pages,
+                                          mmap_window);
 }
 
 } // namespace databento
@@ -0,0 +1,190 @@
+#include "databento/perf.hpp"
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace databento {
+
+namespace {
+
+struct EventSpec {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr uint64_t cache_miss(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Same order as the PerfSample fields
+constexpr EventSpec EVENTS[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+constexpr uint64_t GROUP_READ_FORMAT =
+    PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+constexpr uint64_t SOLO_READ_FORMAT = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+// group_fd < 0 opens a leader or a solo event (disabled until start());
+// members start enabled and count whenever their leader does
+int open_event(const EventSpec& spec, bool exclude_kernel, int group_fd, uint64_t read_format) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = spec.type;
+  attr.config = spec.config;
+  attr.disabled = group_fd < 0;
+  attr.exclude_kernel = exclude_kernel;
+  attr.exclude_hv = 1;
+  attr.read_format = read_format;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+// Kernel time (page faults, read syscalls) matters for the load phase, but
+// perf_event_paranoid >= 2 only allows user-space counting
+int open_event(const EventSpec& spec, uint64_t read_format, bool& exclude_kernel) {
+  exclude_kernel = false;
+  const int fd = open_event(spec, false, -1, read_format);
+  if (fd >= 0) {
+    return fd;
+  }
+  exclude_kernel = true;
+  return open_event(spec, true, -1, read_format);
+}
+
+// Counts scaled up by enabled / running time when the kernel multiplexed
+std::optional<uint64_t> scale(uint64_t value, uint64_t enabled, uint64_t running) {
+  if (running == 0) {
+    return std::nullopt;
+  }
+  if (running < enabled) {
+    return static_cast<uint64_t>(static_cast<double>(value) * enabled / running);
+  }
+  return value;
+}
+
+std::optional<uint64_t> read_solo(int fd) {
+  uint64_t values[3]; // value, time enabled, time running
+  if (read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+    return std::nullopt;
+  }
+  return scale(values[0], values[1], values[2]);
+}
+
+} // namespace
+
+double PerfSample::ipc() const {
+  return cycles && instructions && *cycles > 0
+             ? static_cast<double>(*instructions) / static_cast<double>(*cycles)
+             : 0.0;
+}
+
+// Cycles leads a group with every other event the PMU can schedule
+// alongside it, so the group is read in one call with one scale factor and
+// the ratios (IPC, misses per cycle) come from the same time window. An
+// event that can't join (too few counters) is counted on its own.
+PerfCounters::PerfCounters() {
+  bool exclude_kernel = false;
+  fds_[0] = open_event(EVENTS[0], GROUP_READ_FORMAT, exclude_kernel);
+  grouped_[0] = fds_[0] >= 0;
+  for (int i = 1; i < NUM_EVENTS; ++i) {
+    fds_[i] = -1;
+    grouped_[i] = false;
+    if (grouped_[0]) {
+      fds_[i] = open_event(EVENTS[i], exclude_kernel, fds_[0], GROUP_READ_FORMAT);
+      grouped_[i] = fds_[i] >= 0;
+    }
+    if (fds_[i] < 0) {
+      bool solo_exclude_kernel = false;
+      fds_[i] = open_event(EVENTS[i], SOLO_READ_FORMAT, solo_exclude_kernel);
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  // Members before the leader
+  for (int i = NUM_EVENTS - 1; i >= 0; --i) {
+    if (fds_[i] >= 0) {
+      close(fds_[i]);
+    }
+  }
+}
+
+bool PerfCounters::supported() {
+  static const bool result = []() {
+    bool exclude_kernel = false;
+    const int fd = open_event(EVENTS[0], SOLO_READ_FORMAT, exclude_kernel);
+    if (fd < 0) {
+      return false;
+    }
+    close(fd);
+    return true;
+  }();
+  return result;
+}
+
+bool PerfCounters::available() const {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The leader's ioctls act on the whole group; solo events one by one
+void PerfCounters::start() {
+  for (int i = 0; i < NUM_EVENTS; ++i) {
+    if (fds_[i] >= 0 && (i == 0 || !grouped_[i])) {
+      const unsigned long flags = grouped_[i] ? PERF_IOC_FLAG_GROUP : 0;
+      ioctl(fds_[i], PERF_EVENT_IOC_RESET, flags);
+      ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, flags);
+    }
+  }
+}
+
+PerfSample PerfCounters::stop() {
+  for (int i = 0; i < NUM_EVENTS; ++i) {
+    if (fds_[i] >= 0 && (i == 0 || !grouped_[i])) {
+      ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, grouped_[i] ? PERF_IOC_FLAG_GROUP : 0);
+    }
+  }
+
+  std::optional<uint64_t> counts[NUM_EVENTS];
+  if (grouped_[0]) {
+    // nr, time enabled, time running, then one value per member in the
+    // order they joined (ascending event index)
+    uint64_t group[3 + NUM_EVENTS];
+    const ssize_t got = read(fds_[0], group, sizeof(group));
+    if (got >= static_cast<ssize_t>(3 * sizeof(uint64_t)) &&
+        got == static_cast<ssize_t>((3 + group[0]) * sizeof(uint64_t))) {
+      uint64_t slot = 0;
+      for (int i = 0; i < NUM_EVENTS && slot < group[0]; ++i) {
+        if (grouped_[i]) {
+          counts[i] = scale(group[3 + slot++], group[1], group[2]);
+        }
+      }
+    }
+  }
+  for (int i = 0; i < NUM_EVENTS; ++i) {
+    if (fds_[i] >= 0 && !grouped_[i]) {
+      counts[i] = read_solo(fds_[i]);
+    }
+  }
+
+  PerfSample sample;
+  sample.cycles = counts[0];
+  sample.instructions = counts[1];
+  sample.llc_misses = counts[2];
+  sample.dtlb_misses = counts[3];
+  sample.branch_misses = counts[4];
+  return sample;
+}
+
+} // namespace databento
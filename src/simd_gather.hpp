@@ -0,0 +1,20 @@
+#pragma once
+
+// Internal to src/: x86 intrinsics for the strided gather kernels
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// GCC 12 flags the _mm*_undefined_* placeholders inside the gather
+// intrinsics as -Wmaybe-uninitialized; bracket only the functions that
+// gather so the warning stays live everywhere else
+#if defined(__GNUC__) && !defined(__clang__)
+#define DATABENTO_GATHER_BEGIN                                                 \
+  _Pragma("GCC diagnostic push")                                              \
+  _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define DATABENTO_GATHER_END _Pragma("GCC diagnostic pop")
+#else
+#define DATABENTO_GATHER_BEGIN
+#define DATABENTO_GATHER_END
+#endif
@@ -0,0 +1,383 @@
+#include "databento/parser.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace databento {
+
+namespace {
+
+size_t align_up(size_t bytes) {
+  return (bytes + DIRECT_IO_ALIGNMENT - 1) & ~(DIRECT_IO_ALIGNMENT - 1);
+}
+
+// Without io_uring, keep the window's block-aligned chunks in flight from
+// one thread each. Returns the bytes read up to the first short chunk.
+size_t pread_direct_chunks(int fd, uint8_t* dst, size_t len, off_t offset, size_t chunk_bytes) {
+  const size_t num_chunks = (len + chunk_bytes - 1) / chunk_bytes;
+  std::vector<std::future<size_t>> reads;
+  reads.reserve(num_chunks);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    const size_t begin = i * chunk_bytes;
+    const size_t n = std::min(chunk_bytes, len - begin);
+    reads.push_back(std::async(std::launch::async, [fd, dst, begin, n, offset]() {
+      return pread_direct(fd, dst + begin, n, offset + static_cast<off_t>(begin));
+    }));
+  }
+
+  size_t total = num_chunks > 0 ? pread_direct(fd, dst, std::min(chunk_bytes, len), offset) : 0;
+  bool contiguous = total == std::min(chunk_bytes, len);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    const size_t got = reads[i - 1].get(); // Rethrows read errors
+    const size_t expected = std::min(chunk_bytes, len - i * chunk_bytes);
+    if (contiguous) {
+      total += got;
+      contiguous = got == expected;
+    }
+  }
+  return total;
+}
+
+} // namespace
+
+// ============================================================================
+// DbnStream Implementation
+// ============================================================================
+
+DbnStream::DbnStream(const std::string& filepath, size_t memory_budget, IoBackend backend,
+                     RType schema)
+    : filepath_(filepath),
+      fd_(-1),
+      size_(0),
+      metadata_offset_(200),  // Standard DBN metadata size
+      schema_(schema),
+      record_size_(record_size_for(schema)),
+      num_records_(0),
+      memory_budget_(memory_budget),
+      window_bytes_(0),
+      backend_(backend == IoBackend::IoUring || backend == IoBackend::Direct ? backend
+                                                                              : IoBackend::Pread),
+      window_offset_{0, 0},
+      direct_fd_(-1),
+      drop_behind_(false),
+      fill_(0),
+      file_pos_(0),
+      end_pos_(0),
+      carry_(0),
+      carry_src_(nullptr),
+      consumed_(false),
+      skip_(0) {
+  if (record_size_ == 0) {
+    throw std::invalid_argument("Unsupported schema for DbnStream");
+  }
+
+  // Each of the two buffers holds one record of headroom for carry-over;
+  // keep reads page-sized when the budget allows it
+  const size_t half = memory_budget_ / 2;
+  if (backend_ == IoBackend::Direct) {
+    // O_DIRECT windows are whole blocks, and each buffer needs one more
+    // block of slack to align where the read lands
+    const size_t headroom = record_size_ + DIRECT_IO_ALIGNMENT;
+    window_bytes_ = half > headroom ? (half - headroom) & ~(DIRECT_IO_ALIGNMENT - 1) : 0;
+    window_bytes_ = std::max(window_bytes_, DIRECT_IO_ALIGNMENT);
+    return;
+  }
+  window_bytes_ = half > record_size_ ? half - record_size_ : 0;
+  if (window_bytes_ >= 4096) {
+    window_bytes_ &= ~static_cast<size_t>(4095);
+  }
+  window_bytes_ = std::max(window_bytes_, record_size_);
+}
+
+DbnStream::~DbnStream() {
+  wait_pending();
+  if (direct_fd_ >= 0) {
+    close(direct_fd_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+void DbnStream::open() {
+  if (fd_ >= 0) {
+    return;
+  }
+
+  fd_ = ::open(filepath_.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error("Failed to open file: " + filepath_);
+  }
+
+  struct stat sb;
+  if (fstat(fd_, &sb) < 0) {
+    close(fd_);
+    fd_ = -1;
+    throw std::runtime_error("Failed to get file size: " + filepath_);
+  }
+
+  size_ = sb.st_size;
+
+  if (backend_ == IoBackend::Direct) {
+    direct_fd_ = ::open(filepath_.c_str(), O_RDONLY | O_DIRECT);
+    if (direct_fd_ < 0) {
+      // tmpfs and some FUSE filesystems refuse O_DIRECT
+      backend_ = IoBackend::Pread;
+      drop_behind_ = true;
+    }
+  }
+
+  // Probe through the O_DIRECT descriptor when there is one, so not even
+  // the first block lands in the page cache
+  alignas(DIRECT_IO_ALIGNMENT) uint8_t head[DIRECT_IO_ALIGNMENT];
+  const ssize_t probed = direct_fd_ >= 0 ? pread(direct_fd_, head, sizeof(head), 0)
+                                         : pread(fd_, head, 4, 0);
+  if (probed >= 4 && is_zstd_frame(head, 4)) {
+    backend_ = IoBackend::Zstd;
+    start_decoder();
+    num_records_ = 0; // Unknown until decoded
+    return;
+  }
+
+  num_records_ = size_ > metadata_offset_ ? (size_ - metadata_offset_) / record_size_ : 0;
+  end_pos_ = metadata_offset_ + num_records_ * record_size_;
+
+  posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  const size_t slack = backend_ == IoBackend::Direct ? DIRECT_IO_ALIGNMENT : 0;
+  for (auto& buffer : buffers_) {
+    buffer.resize(record_size_ + slack + window_bytes_);
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    window_offset_[i] = record_size_;
+    if (backend_ == IoBackend::Direct) {
+      const auto base = reinterpret_cast<uintptr_t>(buffers_[i].data());
+      window_offset_[i] = align_up(base + record_size_) - base;
+    }
+  }
+
+  if (backend_ == IoBackend::IoUring || backend_ == IoBackend::Direct) {
+    if (IoUring::supported()) {
+      uring_ = std::make_unique<IoUring>(static_cast<unsigned>(DIRECT_QUEUE_DEPTH));
+      uring_->register_buffers({
+          {buffers_[0].data(), buffers_[0].size()},
+          {buffers_[1].data(), buffers_[1].size()},
+      });
+    } else if (backend_ == IoBackend::IoUring) {
+      backend_ = IoBackend::Pread;
+    }
+  }
+
+  // O_DIRECT reads start at block 0 and skip the metadata in memory
+  file_pos_ = backend_ == IoBackend::Direct ? 0 : metadata_offset_;
+  skip_ = backend_ == IoBackend::Direct ? metadata_offset_ : 0;
+  schedule_read();
+}
+
+void DbnStream::rewind() {
+  if (fd_ < 0) {
+    open();
+    return;
+  }
+  if (!consumed_) {
+    return;
+  }
+
+  if (decoder_) {
+    start_decoder();
+    consumed_ = false;
+    return;
+  }
+
+  wait_pending();
+  fill_ = 0;
+  file_pos_ = backend_ == IoBackend::Direct ? 0 : metadata_offset_;
+  skip_ = backend_ == IoBackend::Direct ? metadata_offset_ : 0;
+  carry_ = 0;
+  carry_src_ = nullptr;
+  consumed_ = false;
+  schedule_read();
+}
+
+bool DbnStream::next_window(const uint8_t*& records, size_t& count) {
+  if (fd_ < 0) {
+    open();
+  }
+  if (decoder_) {
+    return next_zstd_window(records, count);
+  }
+
+  count = 0;
+  while (count == 0) {
+    if (!pending_.valid()) {
+      return false;
+    }
+
+    size_t got = pending_.get();
+    if (got == 0) {
+      return false; // File shrank underneath us
+    }
+
+    uint8_t* payload = buffers_[fill_].data() + window_offset_[fill_];
+    const size_t skipped = std::min(skip_, got);
+    payload += skipped;
+    got -= skipped;
+    skip_ -= skipped;
+
+    // Stitch the straddling record's head in front of this window
+    uint8_t* start = payload - carry_;
+    if (carry_ > 0) {
+      std::memcpy(start, carry_src_, carry_);
+    }
+
+    const size_t avail = carry_ + got;
+    count = avail / record_size_;
+    carry_ = avail - count * record_size_;
+    carry_src_ = start + count * record_size_;
+    records = start;
+
+    // The caller is done with the other buffer; prefetch into it
+    fill_ ^= 1;
+    schedule_read();
+  }
+
+  consumed_ = true;
+  return true;
+}
+
+void DbnStream::start_decoder() {
+  // Two decoded blocks queued plus one being parsed and one being decoded.
+  // One decoder thread: frame-parallel blocks are whole frames, which would
+  // break the budget for files with large frames.
+  const size_t block_bytes = std::max<size_t>(memory_budget_ / 4, 4096);
+  decoder_.reset();
+  decoder_ = std::make_unique<ZstdDecoder>(filepath_, 1, block_bytes, 2, record_size_);
+  carry_buf_.resize(record_size_);
+  carry_ = 0;
+  skip_ = metadata_offset_;
+}
+
+bool DbnStream::next_zstd_window(const uint8_t*& records, size_t& count) {
+  count = 0;
+  while (count == 0) {
+    // The previous block is recycled by next(), so its straddling tail was
+    // already saved to carry_buf_
+    if (!decoder_->next(block_)) {
+      return false;
+    }
+
+    uint8_t* payload = block_.data();
+    size_t avail = block_.size;
+    const size_t skipped = std::min(skip_, avail);
+    payload += skipped;
+    avail -= skipped;
+    skip_ -= skipped;
+
+    uint8_t* start = payload - carry_;
+    std::memcpy(start, carry_buf_.data(), carry_);
+    avail += carry_;
+
+    count = avail / record_size_;
+    carry_ = avail - count * record_size_;
+    std::memcpy(carry_buf_.data(), start + count * record_size_, carry_);
+    records = start;
+  }
+
+  consumed_ = true;
+  return true;
+}
+
+void DbnStream::parse_mbo(MboCallback callback) {
+  parse_mbo<MboCallback&>(callback);
+}
+
+void DbnStream::parse_trade(TradeCallback callback) {
+  parse_trade<TradeCallback&>(callback);
+}
+
+void DbnStream::parse_mbp1(Mbp1Callback callback) {
+  parse_mbp1<Mbp1Callback&>(callback);
+}
+
+void DbnStream::parse_mbp10(Mbp10Callback callback) {
+  parse_mbp10<Mbp10Callback&>(callback);
+}
+
+void DbnStream::schedule_read() {
+  if (file_pos_ >= end_pos_) {
+    return;
+  }
+
+  const size_t len = std::min(window_bytes_, end_pos_ - file_pos_);
+  uint8_t* dst = buffers_[fill_].data() + window_offset_[fill_];
+  const off_t offset = static_cast<off_t>(file_pos_);
+  const int fd = fd_;
+  file_pos_ += len;
+
+  if (backend_ == IoBackend::Direct) {
+    schedule_direct_read(dst, len, offset);
+    return;
+  }
+
+  if (uring_) {
+    // Only one window is ever in flight, so the ring is never shared
+    IoUring* ring = uring_.get();
+    const size_t chunk = std::max<size_t>(len / ring->capacity(), 64 * 1024);
+    pending_ = std::async(std::launch::async, [ring, fd, dst, len, offset, chunk]() {
+      return ring->read_range(fd, dst, len, offset, chunk);
+    });
+    return;
+  }
+
+  const bool drop_behind = drop_behind_;
+  pending_ = std::async(std::launch::async, [fd, dst, len, offset, drop_behind]() {
+    const size_t got = pread_fully(fd, dst, len, offset);
+    if (drop_behind) {
+      // The window is in our buffer now; a one-pass scan has no use for
+      // the cached pages
+      posix_fadvise(fd, offset, static_cast<off_t>(got), POSIX_FADV_DONTNEED);
+    }
+    return got;
+  });
+}
+
+void DbnStream::schedule_direct_read(uint8_t* dst, size_t len, off_t offset) {
+  // Round the final window up to whole blocks; next_window only uses len
+  const size_t aligned_len = align_up(len);
+
+  // Blocks wholly inside the file are split into queued chunks. The block
+  // holding end of file comes back short, so it is read on its own after.
+  const size_t blocks_end = size_ & ~(DIRECT_IO_ALIGNMENT - 1);
+  const size_t body = static_cast<size_t>(offset) < blocks_end
+                          ? std::min(aligned_len, blocks_end - static_cast<size_t>(offset))
+                          : 0;
+  const size_t chunk = std::max(align_up(body / DIRECT_QUEUE_DEPTH), size_t{64 * 1024});
+
+  const int fd = direct_fd_;
+  IoUring* ring = uring_.get();
+  pending_ = std::async(std::launch::async, [=]() {
+    size_t got = 0;
+    if (body > 0) {
+      got = ring ? ring->read_range(fd, dst, body, offset, chunk)
+                 : pread_direct_chunks(fd, dst, body, offset, chunk);
+    }
+    if (got == body && aligned_len > body) {
+      got += pread_direct(fd, dst + body, aligned_len - body, offset + static_cast<off_t>(body));
+    }
+    return std::min(got, len);
+  });
+}
+
+void DbnStream::wait_pending() {
+  if (pending_.valid()) {
+    pending_.wait();
+    pending_ = std::future<size_t>();
+  }
+}
+
+} // namespace databento
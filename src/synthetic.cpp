@@ -0,0 +1,400 @@
+#include "databento/synthetic.hpp"
+#include "databento/io.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <fcntl.h>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace databento {
+
+namespace {
+
+constexpr uint8_t F_LAST = 0x80; // Last record of an event
+
+uint64_t mix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+void validate(const SyntheticConfig& config) {
+  if (config.num_instruments == 0 || config.max_orders_per_instrument == 0) {
+    throw std::invalid_argument("Synthetic config needs instruments and orders");
+  }
+  if (config.mean_gap_ns == 0 || config.tick <= 0) {
+    throw std::invalid_argument("Synthetic config needs a positive time gap and tick");
+  }
+  if (config.add_weight <= 0 || config.cancel_weight < 0 || config.modify_weight < 0 ||
+      config.trade_weight < 0) {
+    throw std::invalid_argument("Synthetic event weights must be non-negative, adds positive");
+  }
+}
+
+// ============================================================================
+// Chunk Generator
+// ============================================================================
+
+enum class Event { Add, Cancel, Modify, Trade };
+
+class ChunkGenerator {
+public:
+  ChunkGenerator(const SyntheticConfig& config, size_t chunk_index, std::span<MboMsg> out)
+      : config_(config),
+        out_(out),
+        first_record_(chunk_index * SyntheticConfig::CHUNK_RECORDS),
+        rng_(mix64(config.seed ^ mix64(chunk_index))),
+        next_order_id_((static_cast<uint64_t>(chunk_index) + 1) << 40) {
+    double total = 0;
+    for (uint32_t k = 0; k < config.num_instruments; ++k) {
+      total += 1.0 / (k + 1);
+      instrument_cdf_.push_back(total);
+    }
+    for (double& p : instrument_cdf_) {
+      p /= total;
+    }
+
+    const double weights[] = {config.add_weight, config.cancel_weight, config.modify_weight,
+                              config.trade_weight};
+    total = 0;
+    for (double w : weights) {
+      total += w;
+      event_cdf_.push_back(total);
+    }
+    for (double& p : event_cdf_) {
+      p /= total;
+    }
+
+    instruments_.resize(config.num_instruments);
+    for (uint32_t k = 0; k < config.num_instruments; ++k) {
+      instruments_[k].instrument_id = config.first_instrument_id + k;
+      instruments_[k].reference = start_reference(k, chunk_index);
+    }
+  }
+
+  void run() {
+    // Keep room to close every live order plus one whole trade (3 records)
+    while (out_.size() - pos_ >= live_ + 3 + 1) {
+      Instrument& inst = instruments_[pick(instrument_cdf_)];
+      Event event = static_cast<Event>(pick(event_cdf_));
+      if (inst.orders.empty()) {
+        event = Event::Add;
+      } else if (event == Event::Add && inst.orders.size() >= config_.max_orders_per_instrument) {
+        event = Event::Cancel;
+      }
+      switch (event) {
+        case Event::Add: add(inst); break;
+        case Event::Cancel: cancel(inst); break;
+        case Event::Modify: modify(inst); break;
+        case Event::Trade: trade(inst); break;
+      }
+    }
+
+    // Close the chunk's lifecycles, then pad with off-book trades
+    for (Instrument& inst : instruments_) {
+      for (const Order& order : inst.orders) {
+        emit(inst, Action::Cancel, order.bid, order.order_id, order.price, order.size, F_LAST);
+      }
+      live_ -= inst.orders.size();
+      inst.orders.clear();
+      inst.touch[0] = inst.touch[1] = Touch{};
+    }
+    while (pos_ < out_.size()) {
+      Instrument& inst = instruments_[0];
+      MboMsg& msg = emit(inst, Action::Trade, false, 0, inst.reference, 1, F_LAST);
+      msg.side = static_cast<char>(Side::None);
+    }
+  }
+
+private:
+  struct Order {
+    uint64_t order_id;
+    int64_t price; // Ticks from base_price
+    uint32_t size;
+    bool bid;
+  };
+
+  struct Touch {
+    int64_t price = 0;
+    bool valid = false; // Side has orders
+    bool stale = false; // Needs a rescan
+  };
+
+  struct Instrument {
+    uint32_t instrument_id = 0;
+    int64_t reference = 0; // Last trade, in ticks
+    std::vector<Order> orders;
+    Touch touch[2]; // Indexed by bid
+  };
+
+  const SyntheticConfig& config_;
+  std::span<MboMsg> out_;
+  size_t first_record_;
+  size_t pos_ = 0;
+  size_t live_ = 0;
+  std::mt19937_64 rng_;
+  uint64_t next_order_id_;
+  std::vector<double> instrument_cdf_;
+  std::vector<double> event_cdf_;
+  std::vector<Instrument> instruments_;
+
+  // Chunks start where a coarse per-instrument walk over earlier chunks
+  // left off, so prices drift across the file instead of resetting
+  int64_t start_reference(uint32_t instrument, size_t chunk_index) const {
+    std::mt19937_64 walk(mix64(config_.seed + 0x5bd1e995ULL * (instrument + 1)));
+    int64_t ticks = 0;
+    for (size_t c = 0; c < chunk_index; ++c) {
+      ticks += static_cast<int64_t>(walk() % 41) - 20;
+    }
+    return ticks;
+  }
+
+  size_t pick(const std::vector<double>& cdf) {
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    const auto it = std::upper_bound(cdf.begin(), cdf.end(), u);
+    return std::min(static_cast<size_t>(it - cdf.begin()), cdf.size() - 1);
+  }
+
+  // 0 with probability 1/2, 1 with 1/4, ... capped at 8
+  int64_t geometric() { return std::countr_zero(rng_() | (uint64_t{1} << 8)); }
+
+  uint32_t order_size() {
+    uint32_t size = 1 + static_cast<uint32_t>(rng_() % 20);
+    return rng_() % 16 == 0 ? size * 10 : size;
+  }
+
+  // Best price on a side, if it has orders. Cached per side; a scan is
+  // only needed after an order at the touch leaves or moves.
+  static bool best(Instrument& inst, bool bid, int64_t& price) {
+    Touch& touch = inst.touch[bid];
+    if (touch.stale) {
+      touch.stale = false;
+      touch.valid = false;
+      for (const Order& order : inst.orders) {
+        if (order.bid == bid && (!touch.valid || better(bid, order.price, touch.price))) {
+          touch.price = order.price;
+          touch.valid = true;
+        }
+      }
+    }
+    price = touch.price;
+    return touch.valid;
+  }
+
+  static bool better(bool bid, int64_t a, int64_t b) { return bid ? a > b : a < b; }
+
+  // Keep the cached touch in step with an order arriving at price
+  static void on_insert(Instrument& inst, bool bid, int64_t price) {
+    Touch& touch = inst.touch[bid];
+    if (!touch.stale && (!touch.valid || better(bid, price, touch.price))) {
+      touch.price = price;
+      touch.valid = true;
+    }
+  }
+
+  // An order leaving price may have been the last one at the touch
+  static void on_leave(Instrument& inst, bool bid, int64_t price) {
+    Touch& touch = inst.touch[bid];
+    if (touch.valid && touch.price == price) {
+      touch.stale = true;
+    }
+  }
+
+  // Keep a price on its own side of the opposite best, so books never cross
+  int64_t clamp_to_side(Instrument& inst, bool bid, int64_t price) const {
+    int64_t opposite = 0;
+    if (best(inst, !bid, opposite)) {
+      price = bid ? std::min(price, opposite - 1) : std::max(price, opposite + 1);
+    }
+    return price;
+  }
+
+  MboMsg& emit(const Instrument& inst, Action action, bool bid, uint64_t order_id,
+               int64_t price, uint32_t size, uint8_t flags) {
+    const uint64_t index = first_record_ + pos_;
+    MboMsg& msg = out_[pos_++];
+    msg = {};
+    msg.ts_event = config_.start_ts + index * config_.mean_gap_ns + rng_() % config_.mean_gap_ns;
+    msg.instrument_id = inst.instrument_id;
+    msg.action = static_cast<char>(action);
+    msg.side = static_cast<char>(bid ? Side::Bid : Side::Ask);
+    msg.flags = flags;
+    msg.price = config_.base_price + price * config_.tick;
+    msg.size = size;
+    msg.order_id = order_id;
+    msg.sequence = static_cast<uint32_t>(index);
+    return msg;
+  }
+
+  void add(Instrument& inst) {
+    const bool bid = rng_() & 1;
+    int64_t price = 0;
+    if (!best(inst, bid, price)) {
+      price = bid ? inst.reference - 1 : inst.reference + 1;
+    }
+    // Mostly join or sit behind the touch, sometimes improve it
+    const int64_t offset = rng_() % 8 == 0 ? -1 : geometric();
+    price = clamp_to_side(inst, bid, bid ? price - offset : price + offset);
+
+    const Order order{next_order_id_++, price, order_size(), bid};
+    inst.orders.push_back(order);
+    on_insert(inst, bid, price);
+    ++live_;
+    emit(inst, Action::Add, bid, order.order_id, order.price, order.size, F_LAST);
+  }
+
+  void remove(Instrument& inst, size_t i) {
+    on_leave(inst, inst.orders[i].bid, inst.orders[i].price);
+    inst.orders[i] = inst.orders.back();
+    inst.orders.pop_back();
+    --live_;
+  }
+
+  void cancel(Instrument& inst) {
+    const size_t i = rng_() % inst.orders.size();
+    Order& order = inst.orders[i];
+    if (order.size > 1 && rng_() % 5 == 0) {
+      const uint32_t cut = 1 + static_cast<uint32_t>(rng_() % (order.size - 1));
+      order.size -= cut;
+      emit(inst, Action::Cancel, order.bid, order.order_id, order.price, cut, F_LAST);
+    } else {
+      emit(inst, Action::Cancel, order.bid, order.order_id, order.price, order.size, F_LAST);
+      remove(inst, i);
+    }
+  }
+
+  void modify(Instrument& inst) {
+    Order& order = inst.orders[rng_() % inst.orders.size()];
+    if (order.size > 1 && rng_() & 1) {
+      order.size = 1 + static_cast<uint32_t>(rng_() % (order.size - 1));
+    } else {
+      const int64_t step = 1 + static_cast<int64_t>(rng_() % 2);
+      const bool toward_touch = rng_() & 1;
+      const int64_t moved = order.bid == toward_touch ? order.price + step : order.price - step;
+      on_leave(inst, order.bid, order.price);
+      order.price = clamp_to_side(inst, order.bid, moved);
+      order.size = order_size();
+      on_insert(inst, order.bid, order.price);
+    }
+    emit(inst, Action::Modify, order.bid, order.order_id, order.price, order.size, F_LAST);
+  }
+
+  // An aggressor hits the oldest order at the opposite touch
+  void trade(Instrument& inst) {
+    const bool aggressor_bid = rng_() & 1;
+    const bool resting_bid = !aggressor_bid;
+    int64_t touch = 0;
+    if (!best(inst, resting_bid, touch)) {
+      add(inst);
+      return;
+    }
+    size_t oldest = inst.orders.size();
+    for (size_t i = 0; i < inst.orders.size(); ++i) {
+      const Order& order = inst.orders[i];
+      if (order.bid == resting_bid && order.price == touch &&
+          (oldest == inst.orders.size() || order.order_id < inst.orders[oldest].order_id)) {
+        oldest = i;
+      }
+    }
+
+    Order& resting = inst.orders[oldest];
+    const uint32_t qty = rng_() % 3 == 0 ? resting.size
+                                         : 1 + static_cast<uint32_t>(rng_() % resting.size);
+    emit(inst, Action::Trade, aggressor_bid, 0, touch, qty, 0);
+    emit(inst, Action::Fill, resting_bid, resting.order_id, touch, qty, 0);
+    emit(inst, Action::Cancel, resting_bid, resting.order_id, touch, qty, F_LAST);
+    inst.reference = touch;
+    resting.size -= qty;
+    if (resting.size == 0) {
+      remove(inst, oldest);
+    }
+  }
+};
+
+} // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void generate_mbo_chunk(const SyntheticConfig& config, size_t chunk_index,
+                        std::span<MboMsg> out) {
+  validate(config);
+  const size_t start = chunk_index * SyntheticConfig::CHUNK_RECORDS;
+  if (start >= config.num_records ||
+      out.size() != std::min(SyntheticConfig::CHUNK_RECORDS, config.num_records - start)) {
+    throw std::invalid_argument("Output span doesn't match the chunk's length");
+  }
+  ChunkGenerator(config, chunk_index, out).run();
+}
+
+void write_synthetic_dbn(const std::string& path, const SyntheticConfig& config,
+                         size_t num_threads) {
+  validate(config);
+  constexpr size_t METADATA_BYTES = 200;
+
+  const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to create file: " + path);
+  }
+
+  const size_t num_chunks =
+      (config.num_records + SyntheticConfig::CHUNK_RECORDS - 1) / SyntheticConfig::CHUNK_RECORDS;
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = std::max<size_t>(1, std::min(num_threads, num_chunks));
+
+  std::atomic<size_t> next_chunk{0};
+  std::vector<std::exception_ptr> errors(num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+
+  try {
+    const std::vector<uint8_t> metadata(METADATA_BYTES, 0);
+    pwrite_fully(fd, metadata.data(), metadata.size(), 0);
+
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        try {
+          std::vector<MboMsg> buffer;
+          for (size_t chunk; (chunk = next_chunk.fetch_add(1)) < num_chunks;) {
+            const size_t start = chunk * SyntheticConfig::CHUNK_RECORDS;
+            buffer.resize(std::min(SyntheticConfig::CHUNK_RECORDS, config.num_records - start));
+            ChunkGenerator(config, chunk, buffer).run();
+            pwrite_fully(fd, reinterpret_cast<const uint8_t*>(buffer.data()),
+                         buffer.size() * sizeof(MboMsg),
+                         static_cast<off_t>(METADATA_BYTES + start * sizeof(MboMsg)));
+          }
+        } catch (...) {
+          errors[t] = std::current_exception();
+          next_chunk.store(num_chunks); // Stop the other workers early
+        }
+      });
+    }
+  } catch (...) {
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    close(fd);
+    throw;
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  close(fd);
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} // namespace databento
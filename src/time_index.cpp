@@ -0,0 +1,104 @@
+#include "databento/time_index.hpp"
+#include "databento/dbn.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace databento {
+
+namespace {
+
+inline uint64_t ts_at(const uint8_t* records, size_t i, size_t rec_size) {
+  return read_u64_le(records + i * rec_size + offsetof(MboMsg, ts_event));
+}
+
+// Ranges this small are finished by bisection
+constexpr size_t INTERPOLATION_MIN_RECORDS = 64;
+
+} // namespace
+
+// ============================================================================
+// Timestamp Search
+// ============================================================================
+
+size_t lower_bound_ts(const uint8_t* records, size_t count, size_t rec_size, uint64_t ts) {
+  size_t lo = 0;
+  size_t hi = count; // Answer lies in [lo, hi]
+  bool interpolate = true;
+
+  while (hi - lo > INTERPOLATION_MIN_RECORDS) {
+    size_t probe = lo + (hi - lo) / 2;
+    if (interpolate) {
+      const uint64_t first = ts_at(records, lo, rec_size);
+      const uint64_t last = ts_at(records, hi - 1, rec_size);
+      if (ts <= first) {
+        return lo;
+      }
+      if (ts > last) {
+        return hi;
+      }
+      // first < ts <= last here, so the span is non-zero
+      const double fraction = static_cast<double>(ts - first) / static_cast<double>(last - first);
+      probe = lo + std::min(static_cast<size_t>(fraction * static_cast<double>(hi - 1 - lo)), hi - 1 - lo);
+    }
+    // Alternate with bisection to bound the worst case
+    interpolate = !interpolate;
+
+    if (ts_at(records, probe, rec_size) < ts) {
+      lo = probe + 1;
+    } else {
+      hi = probe;
+    }
+  }
+
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (ts_at(records, mid, rec_size) < ts) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// ============================================================================
+// Sparse Time Index
+// ============================================================================
+
+TimeIndex TimeIndex::build(const uint8_t* records, size_t count, size_t rec_size,
+                           size_t block_records) {
+  if (block_records == 0) {
+    throw std::invalid_argument("TimeIndex block_records must be positive");
+  }
+
+  TimeIndex index;
+  index.block_records = block_records;
+  index.num_records = count;
+  const size_t blocks = (count + block_records - 1) / block_records;
+  index.min_ts.resize(blocks);
+  index.max_ts.resize(blocks);
+
+  uint64_t prev = 0;
+  bool sorted = true;
+  for (size_t b = 0; b < blocks; ++b) {
+    const size_t begin = b * block_records;
+    const size_t end = std::min(begin + block_records, count);
+    uint64_t lo = UINT64_MAX;
+    uint64_t hi = 0;
+    for (size_t i = begin; i < end; ++i) {
+      const uint64_t ts = ts_at(records, i, rec_size);
+      lo = std::min(lo, ts);
+      hi = std::max(hi, ts);
+      sorted &= ts >= prev;
+      prev = ts;
+    }
+    index.min_ts[b] = lo;
+    index.max_ts[b] = hi;
+  }
+  index.sorted = sorted;
+  return index;
+}
+
+} // namespace databento
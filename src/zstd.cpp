@@ -0,0 +1,401 @@
+#include "databento/zstd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef DATABENTO_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace databento {
+
+// ============================================================================
+// zstd Detection
+// ============================================================================
+
+bool is_zstd_frame(const uint8_t* data, size_t size) {
+  if (size < 4) {
+    return false;
+  }
+  uint32_t magic;
+  std::memcpy(&magic, data, sizeof(magic));
+  // Skippable frames use magics 0x184D2A50..0x184D2A5F
+  return magic == ZSTD_FRAME_MAGIC || (magic & 0xFFFFFFF0U) == 0x184D2A50U;
+}
+
+bool is_zstd_file(const std::string& filepath) {
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  uint8_t head[4];
+  const ssize_t n = pread(fd, head, sizeof(head), 0);
+  close(fd);
+  return n == static_cast<ssize_t>(sizeof(head)) && is_zstd_frame(head, sizeof(head));
+}
+
+bool zstd_supported() {
+#ifdef DATABENTO_HAS_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+// ============================================================================
+// ZstdDecoder Implementation
+// ============================================================================
+
+#ifdef DATABENTO_HAS_ZSTD
+
+struct ZstdDecoder::Impl {
+  std::string filepath;
+  int fd = -1;
+  const uint8_t* input = nullptr;
+  size_t input_size = 0;
+  size_t block_bytes;
+  size_t queue_depth;
+  size_t headroom;
+
+  std::vector<std::pair<size_t, size_t>> frames; // (offset, size); empty = sequential
+  uint64_t content_size = 0;
+  std::atomic<size_t> next_frame{0};
+
+  // Ordered bounded queue: blocks are published by sequence number and
+  // handed out strictly in order
+  std::mutex mutex;
+  std::condition_variable produced;
+  std::condition_variable consumed;
+  std::map<size_t, Block> ready;
+  std::vector<std::vector<uint8_t>> free_storage;
+  size_t next_out = 0;
+  size_t finished_workers = 0;
+  bool stop = false;
+  std::exception_ptr error;
+
+  std::vector<std::thread> workers;
+
+  Impl(const std::string& path, size_t block, size_t depth, size_t room)
+      : filepath(path), block_bytes(std::max<size_t>(block, 4096)),
+        queue_depth(std::max<size_t>(depth, 1)), headroom(room) {}
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    consumed.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    if (input != nullptr) {
+      munmap(const_cast<uint8_t*>(input), input_size);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  void map_input() {
+    fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    struct stat sb;
+    if (fstat(fd, &sb) < 0) {
+      throw std::runtime_error("Failed to get file size: " + filepath);
+    }
+    input_size = sb.st_size;
+    if (input_size == 0) {
+      return;
+    }
+    void* addr = mmap(nullptr, input_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      throw std::runtime_error("Failed to mmap file: " + filepath);
+    }
+    madvise(addr, input_size, MADV_SEQUENTIAL);
+    input = static_cast<const uint8_t*>(addr);
+  }
+
+  void scan_frames() {
+    bool sizes_known = true;
+    for (size_t pos = 0; pos < input_size;) {
+      const size_t frame = ZSTD_findFrameCompressedSize(input + pos, input_size - pos);
+      if (ZSTD_isError(frame)) {
+        throw std::runtime_error("Corrupt zstd stream in " + filepath + ": " + ZSTD_getErrorName(frame));
+      }
+      const unsigned long long content = ZSTD_getFrameContentSize(input + pos, frame);
+      if (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR) {
+        sizes_known = false;
+      } else {
+        content_size += content;
+      }
+      frames.emplace_back(pos, frame);
+      pos += frame;
+    }
+    if (!sizes_known) {
+      content_size = 0;
+    }
+  }
+
+  std::vector<uint8_t> acquire_storage() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (free_storage.empty()) {
+      return {};
+    }
+    std::vector<uint8_t> storage = std::move(free_storage.back());
+    free_storage.pop_back();
+    return storage;
+  }
+
+  // Blocks until seq fits in the queue window; false if shutting down
+  bool wait_for_slot(size_t seq) {
+    std::unique_lock<std::mutex> lock(mutex);
+    consumed.wait(lock, [&] { return stop || seq < next_out + queue_depth; });
+    return !stop;
+  }
+
+  void publish(size_t seq, Block&& block) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ready.emplace(seq, std::move(block));
+    }
+    produced.notify_all();
+  }
+
+  void worker_done(std::exception_ptr failure) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (failure && !error) {
+        error = failure;
+      }
+      ++finished_workers;
+    }
+    produced.notify_all();
+  }
+
+  // Single-frame path: stream the whole input into fixed-size blocks
+  void decode_sequential() {
+    std::exception_ptr failure;
+    size_t seq = 0;
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    try {
+      ZSTD_inBuffer in{input, input_size, 0};
+      size_t last = 0;
+      bool more = input_size > 0;
+      bool cancelled = false;
+
+      while (more) {
+        if (!wait_for_slot(seq)) {
+          cancelled = true;
+          break;
+        }
+        Block block;
+        block.storage = acquire_storage();
+        block.storage.resize(headroom + block_bytes);
+        block.offset = headroom;
+
+        ZSTD_outBuffer out{block.data(), block_bytes, 0};
+        for (;;) {
+          last = ZSTD_decompressStream(dctx, &out, &in);
+          if (ZSTD_isError(last)) {
+            throw std::runtime_error("zstd decode failed for " + filepath + ": " + ZSTD_getErrorName(last));
+          }
+          if (out.pos == out.size) {
+            break; // Block full; the decoder may hold more output
+          }
+          if (in.pos == in.size) {
+            more = false;
+            break;
+          }
+        }
+
+        block.size = out.pos;
+        if (block.size > 0) {
+          publish(seq++, std::move(block));
+        }
+      }
+
+      if (!cancelled && last != 0) {
+        throw std::runtime_error("Truncated zstd stream: " + filepath);
+      }
+    } catch (...) {
+      failure = std::current_exception();
+    }
+    ZSTD_freeDCtx(dctx);
+    worker_done(failure);
+  }
+
+  // Multi-frame path: workers claim frames in order and decode each into
+  // its own block
+  void decode_frames() {
+    std::exception_ptr failure;
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    try {
+      for (;;) {
+        const size_t f = next_frame.fetch_add(1);
+        if (f >= frames.size() || !wait_for_slot(f)) {
+          break;
+        }
+
+        const uint8_t* src = input + frames[f].first;
+        const size_t src_size = frames[f].second;
+        // A corrupt header can't force a huge allocation: the declared size
+        // is only trusted up to a plausible ratio
+        const unsigned long long content = ZSTD_getFrameContentSize(src, src_size);
+        const unsigned long long plausible =
+            std::max<unsigned long long>(block_bytes, ZSTD_PREALLOC_RATIO * src_size);
+        size_t capacity = (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR)
+                              ? block_bytes
+                              : static_cast<size_t>(std::max(std::min(content, plausible), 1ULL));
+
+        Block block;
+        block.storage = acquire_storage();
+        block.storage.resize(headroom + capacity);
+        block.offset = headroom;
+
+        ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+        ZSTD_inBuffer in{src, src_size, 0};
+        size_t produced_bytes = 0;
+        for (;;) {
+          ZSTD_outBuffer out{block.data() + produced_bytes, capacity - produced_bytes, 0};
+          const size_t ret = ZSTD_decompressStream(dctx, &out, &in);
+          if (ZSTD_isError(ret)) {
+            throw std::runtime_error("zstd decode failed for " + filepath + ": " + ZSTD_getErrorName(ret));
+          }
+          produced_bytes += out.pos;
+          if (ret == 0) {
+            break; // Frame complete
+          }
+          if (produced_bytes == capacity) {
+            capacity *= 2;
+            block.storage.resize(headroom + capacity);
+          } else if (in.pos == in.size) {
+            throw std::runtime_error("Truncated zstd frame in " + filepath);
+          }
+        }
+
+        block.size = produced_bytes;
+        publish(f, std::move(block));
+      }
+    } catch (...) {
+      failure = std::current_exception();
+    }
+    ZSTD_freeDCtx(dctx);
+    worker_done(failure);
+  }
+};
+
+ZstdDecoder::ZstdDecoder(const std::string& filepath, size_t num_threads,
+                         size_t block_bytes, size_t queue_depth, size_t headroom)
+    : impl_(std::make_unique<Impl>(filepath, block_bytes, queue_depth, headroom)) {
+  impl_->map_input();
+
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Frame boundaries are only needed (and only worth the scan) for
+  // frame-parallel decoding
+  if (num_threads > 1 && impl_->input_size > 0) {
+    impl_->scan_frames();
+  }
+
+  if (impl_->frames.size() > 1) {
+    // Frames are handed out in order and decoded at most queue_depth ahead,
+    // so the window must cover every worker or the extra ones sit idle
+    const size_t workers = std::min(num_threads, impl_->frames.size());
+    impl_->queue_depth = std::max(impl_->queue_depth, workers);
+    for (size_t t = 0; t < workers; ++t) {
+      impl_->workers.emplace_back([impl = impl_.get()] { impl->decode_frames(); });
+    }
+  } else {
+    impl_->frames.clear();
+    impl_->workers.emplace_back([impl = impl_.get()] { impl->decode_sequential(); });
+  }
+}
+
+ZstdDecoder::~ZstdDecoder() = default;
+
+bool ZstdDecoder::next(Block& block) {
+  Impl& impl = *impl_;
+  std::unique_lock<std::mutex> lock(impl.mutex);
+
+  if (block.storage.capacity() > 0) {
+    impl.free_storage.push_back(std::move(block.storage));
+  }
+  block = Block{};
+
+  impl.produced.wait(lock, [&] {
+    return impl.ready.count(impl.next_out) > 0 || impl.error ||
+           impl.finished_workers == impl.workers.size();
+  });
+
+  auto it = impl.ready.find(impl.next_out);
+  if (it == impl.ready.end()) {
+    if (impl.error) {
+      std::rethrow_exception(impl.error);
+    }
+    return false; // All workers finished and nothing left at next_out
+  }
+
+  block = std::move(it->second);
+  impl.ready.erase(it);
+  ++impl.next_out;
+  lock.unlock();
+  impl.consumed.notify_all();
+  return true;
+}
+
+uint64_t ZstdDecoder::content_size() const {
+  return impl_->content_size;
+}
+
+uint64_t ZstdDecoder::compressed_size() const {
+  return impl_->input_size;
+}
+
+size_t ZstdDecoder::num_threads() const {
+  return impl_->workers.size();
+}
+
+#else // !DATABENTO_HAS_ZSTD
+
+struct ZstdDecoder::Impl {};
+
+ZstdDecoder::ZstdDecoder(const std::string& filepath, size_t, size_t, size_t, size_t) {
+  throw std::runtime_error("Cannot decode " + filepath +
+                           ": databento-cpp was built without zstd support");
+}
+
+ZstdDecoder::~ZstdDecoder() = default;
+
+bool ZstdDecoder::next(Block&) {
+  return false;
+}
+
+uint64_t ZstdDecoder::content_size() const {
+  return 0;
+}
+
+uint64_t ZstdDecoder::compressed_size() const {
+  return 0;
+}
+
+size_t ZstdDecoder::num_threads() const {
+  return 0;
+}
+
+#endif // DATABENTO_HAS_ZSTD
+
+} // namespace databento
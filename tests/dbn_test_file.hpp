@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Shared Test Helpers: DBN files on disk
+// ============================================================================
+
+// A /tmp path unique to the running test. ctest runs every TEST as its own
+// process (in parallel under -j), so fixed names would collide.
+inline std::string test_file_path(const std::string& suffix = ".dbn") {
+  const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+  std::string name = std::string("/tmp/test_databento_") + info->test_suite_name() + "_" +
+                     info->name();
+  // Parameterized tests are named Prefix/Suite.Test/N
+  std::replace(name.begin() + 5, name.end(), '/', '_');
+  return name + suffix;
+}
+
+// Zeroed metadata block the parser skips before the first record
+constexpr size_t TEST_METADATA_BYTES = 200;
+
+// Write records (MboMsg, TradeMsg, Mbp10Msg, ...) after a zeroed metadata
+// block, the minimal file DbnParser reads
+template<typename T>
+void write_dbn_file(const std::string& path, std::span<const T> records) {
+  std::ofstream out(path, std::ios::binary);
+  const std::vector<char> metadata(TEST_METADATA_BYTES, 0);
+  out.write(metadata.data(), metadata.size());
+  out.write(reinterpret_cast<const char*>(records.data()), records.size_bytes());
+}
+
+template<typename T>
+void write_dbn_file(const std::string& path, const std::vector<T>& records) {
+  write_dbn_file(path, std::span<const T>(records));
+}
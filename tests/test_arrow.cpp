@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <databento/arrow.hpp>
+#include <databento/dbn.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "dbn_test_file.hpp"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+static std::vector<databento::MboMsg> write_mbo_file(const std::string& path, size_t count) {
+  std::vector<databento::MboMsg> records(count);
+  for (size_t i = 0; i < count; ++i) {
+    records[i].ts_event = 1000 + i;
+    records[i].instrument_id = static_cast<uint32_t>(i % 3);
+    records[i].action = i % 2 ? 'A' : 'C';
+    records[i].side = 'B';
+    records[i].price = static_cast<int64_t>(i) * 250;
+    records[i].size = static_cast<uint32_t>(i + 1);
+    records[i].order_id = 10 * i;
+  }
+  write_dbn_file(path, records);
+  return records;
+}
+
+template<typename T>
+static T value_at(const ArrowArray* child, size_t i) {
+  T value;
+  std::memcpy(&value, static_cast<const uint8_t*>(child->buffers[1]) + i * sizeof(T), sizeof(T));
+  return value;
+}
+
+// ============================================================================
+// Arrow Export Tests
+// ============================================================================
+
+TEST(ArrowExportTest, SchemaFollowsSelection) {
+  ArrowSchema schema;
+  databento::export_mbo_schema(
+      databento::COL_TS_EVENT | databento::COL_ACTION | databento::COL_PRICE, &schema);
+
+  EXPECT_STREQ(schema.format, "+s");
+  ASSERT_EQ(schema.n_children, 3);
+  EXPECT_STREQ(schema.children[0]->name, "ts_event");
+  EXPECT_STREQ(schema.children[0]->format, "tsn:UTC");
+  EXPECT_STREQ(schema.children[1]->name, "action");
+  EXPECT_STREQ(schema.children[1]->format, "w:1");
+  EXPECT_STREQ(schema.children[2]->name, "price");
+  EXPECT_STREQ(schema.children[2]->format, "l");
+
+  schema.release(&schema);
+  EXPECT_EQ(schema.release, nullptr);
+}
+
+TEST(ArrowExportTest, BatchValuesMatchRecords) {
+  const std::string path = test_file_path();
+  const auto records = write_mbo_file(path, 500);
+  databento::DbnParser parser(path);
+  parser.load_with_mmap();
+
+  ArrowSchema schema;
+  ArrowArray array;
+  databento::export_mbo_batch(parser, 100, 300, databento::COL_ALL, &schema, &array);
+
+  ASSERT_EQ(array.length, 300);
+  ASSERT_EQ(array.n_children, schema.n_children);
+  ASSERT_EQ(array.n_children, 12);
+  for (int64_t c = 0; c < array.n_children; ++c) {
+    EXPECT_EQ(array.children[c]->length, 300);
+    EXPECT_EQ(array.children[c]->n_buffers, 2);
+    EXPECT_EQ(array.children[c]->buffers[0], nullptr); // No nulls
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(array.children[c]->buffers[1]) % 64, 0u);
+  }
+
+  // ts_event, instrument_id, action, ..., price, size, channel_id, order_id
+  for (size_t i = 0; i < 300; ++i) {
+    const auto& rec = records[100 + i];
+    EXPECT_EQ(value_at<uint64_t>(array.children[0], i), rec.ts_event);
+    EXPECT_EQ(value_at<uint32_t>(array.children[1], i), rec.instrument_id);
+    EXPECT_EQ(value_at<char>(array.children[2], i), rec.action);
+    EXPECT_EQ(value_at<int64_t>(array.children[6], i), rec.price);
+    EXPECT_EQ(value_at<uint32_t>(array.children[7], i), rec.size);
+    EXPECT_EQ(value_at<uint64_t>(array.children[9], i), rec.order_id);
+  }
+
+  schema.release(&schema);
+  array.release(&array);
+  EXPECT_EQ(array.release, nullptr);
+  std::remove(path.c_str());
+}
+
+TEST(ArrowExportTest, MovedChildOutlivesParent) {
+  const std::string path = test_file_path();
+  const auto records = write_mbo_file(path, 64);
+  databento::DbnParser parser(path);
+  parser.load_into_memory();
+
+  ArrowSchema schema;
+  ArrowArray array;
+  databento::export_mbo_batch(parser, 0, 64, databento::COL_PRICE | databento::COL_SIZE,
+                              &schema, &array);
+
+  // Move the size column out, as a consumer importing one field would
+  ArrowArray size_column = *array.children[1];
+  array.children[1]->release = nullptr;
+  array.release(&array);
+  schema.release(&schema);
+
+  for (size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(value_at<uint32_t>(&size_column, i), records[i].size);
+  }
+  size_column.release(&size_column);
+  EXPECT_EQ(size_column.release, nullptr);
+  std::remove(path.c_str());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
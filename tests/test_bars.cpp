@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <databento/bars.hpp>
+#include <databento/dbn.hpp>
+#include <databento/parser.hpp>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "dbn_test_file.hpp"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+static databento::TradeMsg make_trade(uint64_t ts, uint32_t instrument_id, int64_t price,
+                                      uint32_t size, char action = 'T') {
+  databento::TradeMsg msg{};
+  msg.ts_event = ts;
+  msg.instrument_id = instrument_id;
+  msg.action = action;
+  msg.price = price;
+  msg.size = size;
+  return msg;
+}
+
+struct RefBar {
+  int64_t open, high, low, close;
+  uint64_t volume;
+};
+
+// (instrument, bucket start) -> bar, by straightforward division
+static std::map<std::pair<uint32_t, uint64_t>, RefBar> reference_bars(
+    const std::vector<databento::TradeMsg>& trades, uint64_t interval) {
+  std::map<std::pair<uint32_t, uint64_t>, RefBar> out;
+  for (const auto& t : trades) {
+    const auto key = std::make_pair(t.instrument_id, t.ts_event / interval * interval);
+    auto it = out.find(key);
+    if (it == out.end()) {
+      out[key] = {t.price, t.price, t.price, t.price, t.size};
+    } else {
+      it->second.high = std::max(it->second.high, t.price);
+      it->second.low = std::min(it->second.low, t.price);
+      it->second.close = t.price;
+      it->second.volume += t.size;
+    }
+  }
+  return out;
+}
+
+static void expect_matches(const databento::OhlcvBars& bars,
+                           const std::map<std::pair<uint32_t, uint64_t>, RefBar>& ref) {
+  ASSERT_EQ(bars.size(), ref.size());
+  for (size_t i = 0; i < bars.size(); ++i) {
+    auto it = ref.find({bars.instrument_id[i], bars.ts_event[i]});
+    ASSERT_NE(it, ref.end()) << "unexpected bar " << i;
+    EXPECT_EQ(bars.open[i], it->second.open);
+    EXPECT_EQ(bars.high[i], it->second.high);
+    EXPECT_EQ(bars.low[i], it->second.low);
+    EXPECT_EQ(bars.close[i], it->second.close);
+    EXPECT_EQ(bars.volume[i], it->second.volume);
+  }
+}
+
+static std::vector<databento::TradeMsg> random_trades(size_t count, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<databento::TradeMsg> trades;
+  uint64_t ts = 1'700'000'000'000'000'000ULL;
+  for (size_t i = 0; i < count; ++i) {
+    ts += rng() % 50'000'000; // Up to 50 ms apart
+    trades.push_back(make_trade(ts, static_cast<uint32_t>(1 + rng() % 5),
+                                1000 + static_cast<int64_t>(rng() % 100),
+                                static_cast<uint32_t>(1 + rng() % 20)));
+  }
+  return trades;
+}
+
+// ============================================================================
+// BarBuilder Tests
+// ============================================================================
+
+TEST(BarBuilderTest, StandardIntervalsMapToOhlcvRtypes) {
+  EXPECT_EQ(databento::ohlcv_rtype(databento::BAR_1S), databento::RType::Ohlcv1S);
+  EXPECT_EQ(databento::ohlcv_rtype(databento::BAR_1M), databento::RType::Ohlcv1M);
+  EXPECT_EQ(databento::ohlcv_rtype(databento::BAR_1H), databento::RType::Ohlcv1H);
+  EXPECT_EQ(databento::ohlcv_rtype(databento::BAR_1D), databento::RType::Ohlcv1D);
+  EXPECT_FALSE(databento::ohlcv_rtype(5 * databento::BAR_1S).has_value());
+  EXPECT_THROW(databento::BarBuilder(std::vector<uint64_t>{}), std::invalid_argument);
+  EXPECT_THROW(databento::BarBuilder(std::vector<uint64_t>{0}), std::invalid_argument);
+}
+
+TEST(BarBuilderTest, SingleTradesBuildBars) {
+  databento::BarBuilder builder({databento::BAR_1S});
+  builder.add(make_trade(1'000'000'000, 1, 100, 5));
+  builder.add(make_trade(1'200'000'000, 1, 103, 1));
+  builder.add(make_trade(1'900'000'000, 1, 98, 2));
+  builder.add(make_trade(2'100'000'000, 1, 99, 4)); // Closes the first bar
+
+  const auto& bars = builder.bars(0);
+  ASSERT_EQ(bars.size(), 1u);
+  EXPECT_EQ(bars.ts_event[0], 1'000'000'000u);
+  EXPECT_EQ(bars.open[0], 100);
+  EXPECT_EQ(bars.high[0], 103);
+  EXPECT_EQ(bars.low[0], 98);
+  EXPECT_EQ(bars.close[0], 98);
+  EXPECT_EQ(bars.volume[0], 8u);
+
+  builder.flush();
+  ASSERT_EQ(bars.size(), 2u);
+  EXPECT_EQ(bars.ts_event[1], 2'000'000'000u);
+  EXPECT_EQ(bars.volume[1], 4u);
+}
+
+TEST(BarBuilderTest, BatchMatchesReferenceAtAllIntervals) {
+  const auto trades = random_trades(200000, 5);
+  const std::vector<uint64_t> intervals = {databento::BAR_1S, databento::BAR_1M,
+                                           databento::BAR_1H, 7 * databento::BAR_1S};
+  databento::BarBuilder builder(intervals);
+  builder.consume(reinterpret_cast<const uint8_t*>(trades.data()), trades.size(),
+                  sizeof(databento::TradeMsg));
+  builder.flush();
+
+  for (size_t k = 0; k < intervals.size(); ++k) {
+    EXPECT_EQ(builder.bars(k).interval_ns, intervals[k]);
+    expect_matches(builder.bars(k), reference_bars(trades, intervals[k]));
+  }
+}
+
+TEST(BarBuilderTest, MboSourceSkipsBookUpdates) {
+  std::vector<databento::TradeMsg> records = {
+      make_trade(10, 1, 100, 5, 'A'),
+      make_trade(20, 1, 101, 3, 'T'),
+      make_trade(20, 1, 101, 3, 'F'),
+      make_trade(30, 1, 50, 9, 'C'),
+      make_trade(40, 1, 102, 2, 'T'),
+  };
+  const auto* data = reinterpret_cast<const uint8_t*>(records.data());
+
+  databento::BarBuilder trades_only({databento::BAR_1S});
+  trades_only.consume(data, records.size(), sizeof(databento::MboMsg),
+                      databento::BarSource::MboTrades);
+  trades_only.flush();
+  ASSERT_EQ(trades_only.bars(0).size(), 1u);
+  EXPECT_EQ(trades_only.bars(0).open[0], 101);
+  EXPECT_EQ(trades_only.bars(0).low[0], 101);
+  EXPECT_EQ(trades_only.bars(0).volume[0], 5u);
+
+  databento::BarBuilder with_fills({databento::BAR_1S});
+  with_fills.consume(data, records.size(), sizeof(databento::MboMsg),
+                     databento::BarSource::MboTradesAndFills);
+  with_fills.flush();
+  EXPECT_EQ(with_fills.bars(0).volume[0], 8u);
+}
+
+TEST(BarBuilderTest, ConsumeParser) {
+  const std::string path = test_file_path();
+  const auto trades = random_trades(100000, 9);
+  write_dbn_file(path, trades);
+
+  databento::DbnParser parser(path, databento::RType::Trade);
+  databento::BarBuilder builder;
+  builder.consume(parser);
+  builder.flush();
+  ASSERT_EQ(builder.num_intervals(), 4u);
+  expect_matches(builder.bars(0), reference_bars(trades, databento::BAR_1S));
+  expect_matches(builder.bars(1), reference_bars(trades, databento::BAR_1M));
+
+  databento::DbnParser mbp(path, databento::RType::Mbp1);
+  EXPECT_THROW(builder.consume(mbp), std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+TEST(BarBuilderTest, ConsumeMboParserNeedsMboSource) {
+  const std::string path = test_file_path();
+  const std::vector<databento::TradeMsg> records = {
+      make_trade(10, 1, 100, 5, 'A'),
+      make_trade(20, 1, 101, 3, 'T'),
+      make_trade(30, 1, 50, 9, 'C'),
+  };
+  write_dbn_file(path, records);
+
+  // The schema defaults to MBO: the default Trades source would count the
+  // add and cancel as trades
+  databento::DbnParser parser(path);
+  databento::BarBuilder builder({databento::BAR_1S});
+  EXPECT_THROW(builder.consume(parser), std::invalid_argument);
+
+  builder.consume(parser, databento::BarSource::MboTrades);
+  builder.flush();
+  ASSERT_EQ(builder.bars(0).size(), 1u);
+  EXPECT_EQ(builder.bars(0).open[0], 101);
+  EXPECT_EQ(builder.bars(0).volume[0], 3u);
+  std::remove(path.c_str());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include <databento/book.hpp>
+#include <databento/dbn.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+static databento::MboMsg make_msg(char action, char side, uint64_t order_id,
+                                  int64_t price, uint32_t size, uint32_t instrument_id = 1) {
+  databento::MboMsg msg{};
+  msg.instrument_id = instrument_id;
+  msg.action = action;
+  msg.side = side;
+  msg.order_id = order_id;
+  msg.price = price;
+  msg.size = size;
+  return msg;
+}
+
+// Straightforward std::map book with the same semantics, for comparison
+class ReferenceBook {
+public:
+  void apply(const databento::MboMsg& msg) {
+    const bool has_side = msg.side == 'B' || msg.side == 'A';
+    switch (msg.action) {
+      case 'A':
+      case 'M': {
+        auto it = orders_.find(msg.order_id);
+        if (it == orders_.end()) {
+          if (has_side && msg.size > 0) {
+            orders_[msg.order_id] = {msg.side == 'B', msg.price, msg.size};
+          }
+        } else if (msg.size == 0) {
+          orders_.erase(it);
+        } else {
+          if (has_side) {
+            it->second.bid = msg.side == 'B';
+          }
+          it->second.price = msg.price;
+          it->second.size = msg.size;
+        }
+        break;
+      }
+      case 'C': {
+        auto it = orders_.find(msg.order_id);
+        if (it != orders_.end()) {
+          if (msg.size >= it->second.size) {
+            orders_.erase(it);
+          } else {
+            it->second.size -= msg.size;
+          }
+        }
+        break;
+      }
+      case 'R':
+        orders_.clear();
+        break;
+    }
+  }
+
+  // (price, size, count) per level, best first
+  std::vector<databento::PriceLevel> levels(bool bid) const {
+    std::map<int64_t, databento::PriceLevel> by_price;
+    for (const auto& [id, order] : orders_) {
+      if (order.bid == bid) {
+        auto& level = by_price[order.price];
+        level.price = order.price;
+        level.size += order.size;
+        ++level.count;
+      }
+    }
+    std::vector<databento::PriceLevel> out;
+    for (const auto& [price, level] : by_price) {
+      out.push_back(level);
+    }
+    if (bid) {
+      std::reverse(out.begin(), out.end());
+    }
+    return out;
+  }
+
+  size_t num_orders() const { return orders_.size(); }
+
+private:
+  struct Order {
+    bool bid;
+    int64_t price;
+    uint32_t size;
+  };
+  std::unordered_map<uint64_t, Order> orders_;
+};
+
+static void expect_same_levels(const databento::OrderBook& book, const ReferenceBook& ref) {
+  for (bool bid : {true, false}) {
+    const auto expected = ref.levels(bid);
+    ASSERT_EQ(bid ? book.num_bid_levels() : book.num_ask_levels(), expected.size());
+    std::vector<databento::PriceLevel> actual(expected.size());
+    ASSERT_EQ(bid ? book.bids(actual) : book.asks(actual), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i].price, expected[i].price) << (bid ? "bid" : "ask") << " depth " << i;
+      EXPECT_EQ(actual[i].size, expected[i].size) << (bid ? "bid" : "ask") << " depth " << i;
+      EXPECT_EQ(actual[i].count, expected[i].count) << (bid ? "bid" : "ask") << " depth " << i;
+    }
+  }
+  EXPECT_EQ(book.num_orders(), ref.num_orders());
+}
+
+// ============================================================================
+// OrderIdMap Tests
+// ============================================================================
+
+TEST(OrderIdMapTest, InsertFindEraseWithGrowth) {
+  databento::OrderIdMap map(4);
+  std::unordered_map<uint64_t, uint32_t> ref;
+  std::mt19937_64 rng(3);
+
+  for (uint32_t step = 0; step < 50000; ++step) {
+    const uint64_t key = rng() % 4096;
+    if (ref.count(key)) {
+      map.erase(key);
+      ref.erase(key);
+    } else {
+      map.insert(key, step);
+      ref[key] = step;
+    }
+  }
+
+  EXPECT_EQ(map.size(), ref.size());
+  for (uint64_t key = 0; key < 4096; ++key) {
+    auto it = ref.find(key);
+    EXPECT_EQ(map.find(key), it == ref.end() ? databento::OrderIdMap::NONE : it->second);
+  }
+}
+
+// ============================================================================
+// OrderBook Tests
+// ============================================================================
+
+TEST(OrderBookTest, BboAndDepth) {
+  databento::OrderBook book;
+  book.apply(make_msg('A', 'B', 1, 100, 10));
+  book.apply(make_msg('A', 'B', 2, 101, 5));
+  book.apply(make_msg('A', 'B', 3, 101, 7));
+  book.apply(make_msg('A', 'A', 4, 103, 4));
+  book.apply(make_msg('A', 'A', 5, 102, 6));
+
+  auto bbo = book.bbo();
+  EXPECT_EQ(bbo.bid.price, 101);
+  EXPECT_EQ(bbo.bid.size, 12u);
+  EXPECT_EQ(bbo.bid.count, 2u);
+  EXPECT_EQ(bbo.ask.price, 102);
+  EXPECT_EQ(bbo.ask.size, 6u);
+
+  EXPECT_EQ(book.bid_level(1).price, 100);
+  EXPECT_EQ(book.ask_level(1).price, 103);
+  EXPECT_EQ(book.bid_level(2).price, databento::UNDEF_PRICE);
+  EXPECT_EQ(book.bid_level(2).size, 0u);
+}
+
+TEST(OrderBookTest, CancelModifyClear) {
+  databento::OrderBook book;
+  book.apply(make_msg('A', 'B', 1, 100, 10));
+  book.apply(make_msg('C', 'B', 1, 100, 4)); // Partial cancel
+  EXPECT_EQ(book.bbo().bid.size, 6u);
+
+  book.apply(make_msg('M', 'B', 1, 99, 6)); // Price change moves the level
+  EXPECT_EQ(book.bbo().bid.price, 99);
+  EXPECT_EQ(book.num_bid_levels(), 1u);
+
+  book.apply(make_msg('T', 'A', 0, 99, 3)); // Trades don't touch the book
+  book.apply(make_msg('F', 'B', 1, 99, 3));
+  EXPECT_EQ(book.bbo().bid.size, 6u);
+
+  book.apply(make_msg('C', 'B', 1, 99, 6));
+  EXPECT_EQ(book.num_orders(), 0u);
+  EXPECT_EQ(book.bbo().bid.price, databento::UNDEF_PRICE);
+
+  book.apply(make_msg('C', 'B', 42, 99, 6)); // Unknown order is ignored
+  book.apply(make_msg('A', 'A', 7, 105, 1));
+  book.apply(make_msg('R', 'N', 0, 0, 0));
+  EXPECT_EQ(book.num_orders(), 0u);
+  EXPECT_EQ(book.num_ask_levels(), 0u);
+}
+
+TEST(OrderBookTest, RandomUpdatesMatchReference) {
+  databento::OrderBook book(16);
+  ReferenceBook ref;
+  std::mt19937_64 rng(11);
+  std::vector<uint64_t> live;
+  uint64_t next_id = 1;
+
+  for (int step = 0; step < 40000; ++step) {
+    const int op = static_cast<int>(rng() % 10);
+    databento::MboMsg msg;
+    if (op < 5 || live.empty()) {
+      // Prices cluster around the touch with a long tail of deep levels
+      const bool bid = rng() % 2 == 0;
+      const int64_t offset = static_cast<int64_t>(rng() % 4 == 0 ? rng() % 200 : rng() % 8);
+      msg = make_msg('A', bid ? 'B' : 'A', next_id, bid ? 1000 - offset : 1001 + offset,
+                     static_cast<uint32_t>(1 + rng() % 50));
+      live.push_back(next_id++);
+    } else {
+      const size_t pick = rng() % live.size();
+      const uint64_t id = live[pick];
+      if (op < 8) {
+        msg = make_msg('C', 'N', id, 0, static_cast<uint32_t>(rng() % 60));
+      } else {
+        msg = make_msg('M', 'N', id, 990 + static_cast<int64_t>(rng() % 20),
+                       static_cast<uint32_t>(rng() % 60));
+      }
+      if (rng() % 4 == 0) {
+        live[pick] = live.back();
+        live.pop_back();
+      }
+    }
+    book.apply(msg);
+    ref.apply(msg);
+
+    if (step % 1000 == 0) {
+      expect_same_levels(book, ref);
+    }
+  }
+  expect_same_levels(book, ref);
+}
+
+TEST(OrderBookTest, PriorityKeptOnSizeDecrease) {
+  // Queue order is internal, but a reduce-then-cancel sequence must still
+  // leave the other order at the level intact
+  databento::OrderBook book;
+  book.apply(make_msg('A', 'A', 1, 200, 10));
+  book.apply(make_msg('A', 'A', 2, 200, 10));
+  book.apply(make_msg('M', 'A', 1, 200, 4));
+  EXPECT_EQ(book.bbo().ask.size, 14u);
+  book.apply(make_msg('M', 'A', 2, 200, 12)); // Size increase requeues
+  EXPECT_EQ(book.bbo().ask.size, 16u);
+  book.apply(make_msg('C', 'A', 1, 200, 4));
+  EXPECT_EQ(book.bbo().ask.size, 12u);
+  EXPECT_EQ(book.bbo().ask.count, 1u);
+}
+
+// ============================================================================
+// BookBuilder Tests
+// ============================================================================
+
+TEST(BookBuilderTest, BooksArePerInstrument) {
+  databento::BookBuilder builder;
+  builder.apply(make_msg('A', 'B', 1, 100, 10, 7));
+  builder.apply(make_msg('A', 'B', 1, 200, 20, 8)); // Same order id, other instrument
+  builder.apply(make_msg('A', 'A', 2, 101, 5, 7));
+
+  ASSERT_EQ(builder.num_books(), 2u);
+  ASSERT_NE(builder.find(7), nullptr);
+  EXPECT_EQ(builder.find(7)->bbo().bid.price, 100);
+  EXPECT_EQ(builder.find(7)->bbo().ask.price, 101);
+  EXPECT_EQ(builder.find(8)->bbo().bid.size, 20u);
+  EXPECT_EQ(builder.find(9), nullptr);
+
+  builder.apply(make_msg('R', 'N', 0, 0, 0, 7));
+  EXPECT_EQ(builder.find(7)->num_orders(), 0u);
+  EXPECT_EQ(builder.find(8)->num_orders(), 1u);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
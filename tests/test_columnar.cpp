@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <databento/columnar.hpp>
+#include <databento/dbn.hpp>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// ============================================================================
+// Test Helper: Packed records with every field varied
+// ============================================================================
+
+static std::vector<databento::MboMsg> make_records(size_t count, uint32_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  const char actions[] = {'A', 'C', 'M', 'R', 'T', 'F'};
+  const char sides[] = {'A', 'B', 'N'};
+
+  std::vector<databento::MboMsg> records(count);
+  for (auto& msg : records) {
+    msg.ts_event = rng();
+    msg.instrument_id = static_cast<uint32_t>(rng());
+    msg.action = actions[rng() % 6];
+    msg.side = sides[rng() % 3];
+    msg.flags = static_cast<uint8_t>(rng());
+    msg.depth = static_cast<uint8_t>(rng());
+    msg.price = static_cast<int64_t>(rng());
+    msg.size = static_cast<uint32_t>(rng());
+    msg.channel_id = static_cast<uint32_t>(rng());
+    msg.order_id = rng();
+    msg.sequence = static_cast<uint32_t>(rng());
+    msg.ts_in_delta = static_cast<uint8_t>(rng());
+    std::memset(msg.reserved, 0xEE, sizeof(msg.reserved));
+  }
+  return records;
+}
+
+// ============================================================================
+// Columnar Decoding Tests
+// ============================================================================
+
+TEST(ColumnarTest, AllColumnsMatchRecords) {
+  // Odd counts exercise the scalar tails after the SIMD body
+  for (size_t count : {0, 1, 7, 15, 16, 33, 1001}) {
+    auto records = make_records(count);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(records.data());
+
+    databento::MboColumns cols;
+    databento::decode_mbo_columns(bytes, count, sizeof(databento::MboMsg),
+                                  databento::COL_ALL, cols);
+
+    ASSERT_EQ(cols.count, count);
+    for (size_t i = 0; i < count; ++i) {
+      const auto& msg = records[i];
+      EXPECT_EQ(cols.ts_event[i], msg.ts_event);
+      EXPECT_EQ(cols.instrument_id[i], msg.instrument_id);
+      EXPECT_EQ(cols.action[i], msg.action);
+      EXPECT_EQ(cols.side[i], msg.side);
+      EXPECT_EQ(cols.flags[i], msg.flags);
+      EXPECT_EQ(cols.depth[i], msg.depth);
+      EXPECT_EQ(cols.price[i], msg.price);
+      EXPECT_EQ(cols.size[i], msg.size);
+      EXPECT_EQ(cols.channel_id[i], msg.channel_id);
+      EXPECT_EQ(cols.order_id[i], msg.order_id);
+      EXPECT_EQ(cols.sequence[i], msg.sequence);
+      EXPECT_EQ(cols.ts_in_delta[i], msg.ts_in_delta);
+    }
+  }
+}
+
+TEST(ColumnarTest, SelectedColumnsOnly) {
+  auto records = make_records(100);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(records.data());
+
+  databento::MboColumns cols;
+  databento::decode_mbo_columns(bytes, 100, 48, databento::COL_ALL, cols);
+  databento::decode_mbo_columns(bytes, 50, 48, databento::COL_PRICE | databento::COL_SIDE, cols);
+
+  EXPECT_EQ(cols.count, 50);
+  EXPECT_EQ(cols.price.size(), 50);
+  EXPECT_EQ(cols.side.size(), 50);
+  EXPECT_TRUE(cols.ts_event.empty());
+  EXPECT_TRUE(cols.order_id.empty());
+  EXPECT_EQ(cols.side[49], records[49].side);
+}
+
+TEST(ColumnarTest, BuffersAreAlignedAndReused) {
+  auto records = make_records(64);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(records.data());
+
+  databento::MboColumns cols;
+  databento::decode_mbo_columns(bytes, 64, 48, databento::COL_PRICE, cols);
+  const int64_t* first = cols.price.data();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % 64, 0);
+
+  databento::decode_mbo_columns(bytes, 32, 48, databento::COL_PRICE, cols);
+  EXPECT_EQ(cols.price.data(), first);
+}
+
+// ============================================================================
+// MBP Ladder Tests
+// ============================================================================
+
+template<typename Msg>
+static std::vector<Msg> make_mbp_records(size_t count, uint32_t seed = 9) {
+  std::mt19937_64 rng(seed);
+  std::vector<Msg> records(count);
+  for (auto& msg : records) {
+    std::memset(&msg, 0, sizeof(msg));
+    msg.ts_event = rng();
+    msg.instrument_id = static_cast<uint32_t>(rng());
+    for (auto& level : msg.levels) {
+      level.bid_px = static_cast<int64_t>(rng());
+      level.ask_px = static_cast<int64_t>(rng());
+      level.bid_sz = static_cast<uint32_t>(rng());
+      level.ask_sz = static_cast<uint32_t>(rng());
+      level.bid_ct = static_cast<uint32_t>(rng());
+      level.ask_ct = static_cast<uint32_t>(rng());
+    }
+  }
+  return records;
+}
+
+template<typename Msg>
+static void expect_ladders_match(const std::vector<Msg>& records, size_t levels,
+                                 const databento::MbpLadders& ladders) {
+  ASSERT_EQ(ladders.count, records.size());
+  ASSERT_EQ(ladders.levels, levels);
+  for (size_t l = 0; l < levels; ++l) {
+    auto bid_px = ladders.at(ladders.bid_px, l);
+    auto ask_sz = ladders.at(ladders.ask_sz, l);
+    for (size_t i = 0; i < records.size(); ++i) {
+      const auto& level = records[i].levels[l];
+      EXPECT_EQ(bid_px[i], level.bid_px);
+      EXPECT_EQ(ladders.ask_px[l * records.size() + i], level.ask_px);
+      EXPECT_EQ(ladders.bid_sz[l * records.size() + i], level.bid_sz);
+      EXPECT_EQ(ask_sz[i], level.ask_sz);
+      EXPECT_EQ(ladders.bid_ct[l * records.size() + i], level.bid_ct);
+      EXPECT_EQ(ladders.ask_ct[l * records.size() + i], level.ask_ct);
+    }
+  }
+}
+
+TEST(LadderTest, Mbp10LaddersMatchRecords) {
+  // Odd counts and counts past one tile exercise the tails
+  for (size_t count : {0, 1, 7, 17, 65, 300}) {
+    auto records = make_mbp_records<databento::Mbp10Msg>(count);
+    databento::MbpLadders ladders;
+    databento::decode_mbp_ladders(reinterpret_cast<const uint8_t*>(records.data()), count,
+                                  sizeof(databento::Mbp10Msg), 10, ladders);
+    expect_ladders_match(records, 10, ladders);
+  }
+}
+
+TEST(LadderTest, TopLevelsOnlyAndMbp1) {
+  auto mbp10 = make_mbp_records<databento::Mbp10Msg>(33);
+  databento::MbpLadders ladders;
+  databento::decode_mbp_ladders(reinterpret_cast<const uint8_t*>(mbp10.data()), 33,
+                                sizeof(databento::Mbp10Msg), 3, ladders);
+  expect_ladders_match(mbp10, 3, ladders);
+  EXPECT_EQ(ladders.bid_px.size(), 33u * 3);
+
+  auto mbp1 = make_mbp_records<databento::Mbp1Msg>(41);
+  databento::decode_mbp_ladders(reinterpret_cast<const uint8_t*>(mbp1.data()), 41,
+                                sizeof(databento::Mbp1Msg), 1, ladders);
+  expect_ladders_match(mbp1, 1, ladders);
+}
+
+TEST(LadderTest, TooManyLevelsThrows) {
+  auto mbp1 = make_mbp_records<databento::Mbp1Msg>(4);
+  databento::MbpLadders ladders;
+  EXPECT_THROW(databento::decode_mbp_ladders(reinterpret_cast<const uint8_t*>(mbp1.data()), 4,
+                                             sizeof(databento::Mbp1Msg), 2, ladders),
+               std::invalid_argument);
+}
+
+TEST(ColumnarTest, SimdLevelReported) {
+  std::string level = databento::columnar_simd_level();
+  EXPECT_TRUE(level == "avx512" || level == "avx2" || level == "scalar");
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <databento/filter.hpp>
+#include <databento/parser.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "dbn_test_file.hpp"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+// Fields drawn from small ranges so every predicate selects a real subset
+static std::vector<databento::MboMsg> make_records(size_t count, uint32_t seed = 7) {
+  std::mt19937_64 rng(seed);
+  const char actions[] = {'A', 'C', 'M', 'R', 'T', 'F'};
+  const char sides[] = {'A', 'B', 'N'};
+
+  std::vector<databento::MboMsg> records(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto& msg = records[i];
+    msg.ts_event = 1'700'000'000'000'000'000ULL + i * 1000 + rng() % 1000;
+    msg.instrument_id = static_cast<uint32_t>(rng() % 64);
+    msg.action = actions[rng() % 6];
+    msg.side = sides[rng() % 3];
+    msg.flags = static_cast<uint8_t>(rng());
+    msg.depth = static_cast<uint8_t>(rng());
+    msg.price = static_cast<int64_t>(rng() % 2001) - 1000;
+    msg.size = static_cast<uint32_t>(rng());
+    msg.channel_id = static_cast<uint32_t>(rng());
+    msg.order_id = rng();
+    msg.sequence = static_cast<uint32_t>(rng());
+    msg.ts_in_delta = static_cast<uint8_t>(rng());
+  }
+  return records;
+}
+
+static std::vector<uint32_t> reference_select(const std::vector<databento::MboMsg>& records,
+                                              const databento::MboFilter& f) {
+  std::vector<uint32_t> out;
+  for (size_t i = 0; i < records.size(); ++i) {
+    const auto& msg = records[i];
+    bool ok = (f.action == 0 || msg.action == f.action) &&
+              (f.side == 0 || msg.side == f.side) &&
+              msg.price >= f.min_price && msg.price <= f.max_price &&
+              msg.ts_event >= f.min_ts && msg.ts_event <= f.max_ts;
+    if (ok && !f.instrument_ids.empty()) {
+      ok = std::find(f.instrument_ids.begin(), f.instrument_ids.end(), msg.instrument_id) !=
+           f.instrument_ids.end();
+    }
+    if (ok) {
+      out.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  return out;
+}
+
+static void expect_matches_reference(const std::vector<databento::MboMsg>& records,
+                                     const databento::MboFilter& filter) {
+  databento::AlignedBuffer<uint32_t> selection;
+  const size_t n = databento::select_mbo(reinterpret_cast<const uint8_t*>(records.data()),
+                                         records.size(), sizeof(databento::MboMsg),
+                                         filter, selection);
+  const auto expected = reference_select(records, filter);
+  ASSERT_EQ(n, expected.size());
+  ASSERT_EQ(selection.size(), n);
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(selection[i], expected[i]) << "at selection " << i;
+  }
+}
+
+// ============================================================================
+// Filter Tests
+// ============================================================================
+
+TEST(FilterTest, EmptyFilterSelectsAll) {
+  // Odd counts exercise the scalar tails after the SIMD body
+  for (size_t count : {0, 1, 7, 15, 16, 33, 1001}) {
+    expect_matches_reference(make_records(count), databento::MboFilter{});
+  }
+}
+
+TEST(FilterTest, SinglePredicates) {
+  auto records = make_records(1001);
+  const uint64_t ts0 = records.front().ts_event;
+
+  databento::MboFilter by_action;
+  by_action.action = 'T';
+  expect_matches_reference(records, by_action);
+
+  databento::MboFilter by_side;
+  by_side.side = 'B';
+  expect_matches_reference(records, by_side);
+
+  databento::MboFilter by_price;
+  by_price.min_price = -100;
+  by_price.max_price = 250;
+  expect_matches_reference(records, by_price);
+
+  databento::MboFilter by_ts;
+  by_ts.min_ts = ts0 + 100'000;
+  by_ts.max_ts = ts0 + 500'000;
+  expect_matches_reference(records, by_ts);
+
+  databento::MboFilter by_id;
+  by_id.instrument_ids = {3, 17, 42};
+  expect_matches_reference(records, by_id);
+}
+
+TEST(FilterTest, CombinedPredicates) {
+  auto records = make_records(4097);
+  const uint64_t ts0 = records.front().ts_event;
+
+  databento::MboFilter filter;
+  filter.action = 'A';
+  filter.side = 'A';
+  filter.min_price = -500;
+  filter.max_price = 500;
+  filter.min_ts = ts0 + 1'000'000;
+  filter.max_ts = ts0 + 3'000'000;
+  filter.instrument_ids = {1, 2, 3, 5, 8, 13, 21, 34, 55};
+  expect_matches_reference(records, filter);
+}
+
+TEST(FilterTest, LargeInstrumentSet) {
+  // More ids than the broadcast-compare path handles, with duplicates
+  auto records = make_records(2003);
+  databento::MboFilter filter;
+  for (uint32_t id = 0; id < 64; id += 2) {
+    filter.instrument_ids.push_back(id);
+    filter.instrument_ids.push_back(id);
+  }
+  filter.side = 'N';
+  expect_matches_reference(records, filter);
+
+  filter.side = 0;
+  expect_matches_reference(records, filter);
+}
+
+TEST(FilterTest, UnsignedTimestampBounds) {
+  // Timestamps above INT64_MAX must compare as unsigned
+  auto records = make_records(100);
+  for (size_t i = 0; i < records.size(); i += 2) {
+    records[i].ts_event |= 1ULL << 63;
+  }
+  databento::MboFilter filter;
+  filter.min_ts = 1ULL << 63;
+  expect_matches_reference(records, filter);
+
+  filter.min_ts = 0;
+  filter.max_ts = (1ULL << 63) - 1;
+  expect_matches_reference(records, filter);
+}
+
+TEST(FilterTest, NoMatches) {
+  auto records = make_records(999);
+  databento::MboFilter filter;
+  filter.min_price = 5000;
+  databento::AlignedBuffer<uint32_t> selection;
+  EXPECT_EQ(databento::select_mbo(reinterpret_cast<const uint8_t*>(records.data()),
+                                  records.size(), sizeof(databento::MboMsg), filter, selection),
+            0u);
+  EXPECT_EQ(selection.size(), 0u);
+}
+
+TEST(FilterTest, ParserSelectionUsesAbsoluteIndices) {
+  auto records = make_records(5000);
+  const std::string path = test_file_path();
+  write_dbn_file(path, records);
+
+  databento::MboFilter filter;
+  filter.action = 'C';
+  filter.instrument_ids = {7, 9};
+
+  databento::DbnParser parser(path);
+  const auto selected = databento::select_mbo(parser, filter);
+  std::remove(path.c_str());
+  const auto expected = reference_select(records, filter);
+  ASSERT_EQ(selected.size(), expected.size());
+  for (size_t i = 0; i < selected.size(); ++i) {
+    EXPECT_EQ(selected[i], expected[i]);
+  }
+}
+
+TEST(FilterTest, RejectsOversizedCount) {
+  databento::MboFilter filter;
+  databento::AlignedBuffer<uint32_t> selection;
+  // Checked before the records are touched
+  EXPECT_THROW(databento::select_mbo(nullptr, size_t{UINT32_MAX} + 1, sizeof(databento::MboMsg),
+                                     filter, selection),
+               std::invalid_argument);
+}
+
+TEST(FilterTest, ParserSelectionRejectsOtherSchemas) {
+  const std::string path = test_file_path();
+  write_dbn_file(path, std::vector<databento::TradeMsg>(10));
+
+  databento::DbnParser mbp(path, databento::RType::Mbp10);
+  EXPECT_THROW(databento::select_mbo(mbp, databento::MboFilter{}), std::invalid_argument);
+  databento::DbnParser trades(path, databento::RType::Trade);
+  const auto selected = databento::select_mbo(trades, databento::MboFilter{});
+  EXPECT_EQ(selected.size(), 10u);
+  std::remove(path.c_str());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
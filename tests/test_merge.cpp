@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <databento/dbn.hpp>
+#include <databento/merge.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "dbn_test_file.hpp"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+// Sorted MBO file; order_id encodes (file, position) so the merge order can
+// be checked record by record
+static std::vector<databento::MboMsg> write_sorted_file(const std::string& path, uint32_t file,
+                                                        size_t count, std::mt19937_64& rng) {
+  std::vector<databento::MboMsg> records(count);
+  uint64_t ts = rng() % 1000;
+  for (size_t i = 0; i < count; ++i) {
+    ts += rng() % 4; // Frequent equal timestamps across files
+    records[i].ts_event = ts;
+    records[i].instrument_id = file;
+    records[i].order_id = (static_cast<uint64_t>(file) << 32) | i;
+  }
+  write_dbn_file(path, records);
+  return records;
+}
+
+// Stable merge reference: (ts_event, file, position)
+static std::vector<databento::MboMsg> reference_merge(
+    const std::vector<std::vector<databento::MboMsg>>& files) {
+  std::vector<databento::MboMsg> all;
+  for (const auto& file : files) {
+    all.insert(all.end(), file.begin(), file.end());
+  }
+  std::stable_sort(all.begin(), all.end(), [](const auto& a, const auto& b) {
+    return std::tie(a.ts_event, a.instrument_id) < std::tie(b.ts_event, b.instrument_id);
+  });
+  return all;
+}
+
+class MergedReaderTest : public ::testing::TestWithParam<size_t> {
+protected:
+  void TearDown() override {
+    for (const auto& path : paths_) {
+      std::remove(path.c_str());
+    }
+  }
+
+  std::vector<std::vector<databento::MboMsg>> make_files(size_t num_files, size_t max_records) {
+    std::mt19937_64 rng(num_files);
+    std::vector<std::vector<databento::MboMsg>> files;
+    for (size_t f = 0; f < num_files; ++f) {
+      paths_.push_back(test_file_path("_" + std::to_string(f) + ".dbn"));
+      // Some files are empty
+      const size_t count = f % 5 == 3 ? 0 : rng() % max_records;
+      files.push_back(write_sorted_file(paths_.back(), static_cast<uint32_t>(f), count, rng));
+    }
+    return files;
+  }
+
+  std::vector<std::string> paths_;
+};
+
+// ============================================================================
+// MergedReader Tests
+// ============================================================================
+
+TEST_P(MergedReaderTest, MatchesStableSort) {
+  const auto files = make_files(GetParam(), 5000);
+  const auto expected = reference_merge(files);
+
+  databento::MergedReader reader(paths_);
+  EXPECT_EQ(reader.num_sources(), GetParam());
+  EXPECT_EQ(reader.num_records(), expected.size());
+
+  std::vector<uint64_t> order_ids;
+  reader.parse_mbo([&](const databento::MboMsg& msg) { order_ids.push_back(msg.order_id); });
+  ASSERT_EQ(order_ids.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(order_ids[i], expected[i].order_id) << "record " << i;
+  }
+  EXPECT_EQ(reader.remaining(), 0u);
+}
+
+TEST_P(MergedReaderTest, BatchesReportSourceAndReset) {
+  const auto files = make_files(GetParam(), 2000);
+  const auto expected = reference_merge(files);
+
+  databento::MergedReader reader(paths_);
+  std::vector<databento::MergedRecord> batch(37);
+  for (int pass = 0; pass < 2; ++pass) {
+    size_t seen = 0;
+    for (size_t n; (n = reader.next_batch(batch)) > 0;) {
+      for (size_t i = 0; i < n; ++i, ++seen) {
+        databento::MboMsg msg;
+        std::memcpy(&msg, batch[i].record, sizeof(msg));
+        EXPECT_EQ(batch[i].source, msg.instrument_id);
+        ASSERT_EQ(msg.order_id, expected[seen].order_id);
+      }
+    }
+    EXPECT_EQ(seen, expected.size());
+    reader.reset();
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SourceCounts, MergedReaderTest, ::testing::Values(1, 2, 3, 8, 13));
+
+TEST(MergedReaderErrors, RejectsBadInput) {
+  EXPECT_THROW(databento::MergedReader(std::vector<std::string>{}), std::invalid_argument);
+
+  const std::string path = test_file_path();
+  std::mt19937_64 rng(1);
+  write_sorted_file(path, 0, 10, rng);
+  databento::MergedReader reader({path}, databento::RType::Mbo);
+  EXPECT_THROW(reader.parse_records<databento::Mbp1Msg>([](const databento::Mbp1Msg&) {}),
+               std::runtime_error);
+  std::remove(path.c_str());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
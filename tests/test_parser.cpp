@@ -4,6 +4,17 @@
 #include <vector>
 #include <fstream>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <span>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "dbn_test_file.hpp"
 
 // ============================================================================
 // Test Helper: Create minimal test DBN file
@@ -11,7 +22,8 @@
 
 class TestDbnFile {
 public:
-  TestDbnFile() : path_("/tmp/test_databento_cpp.dbn") {
+  explicit TestDbnFile(int num_records = 10)
+      : path_(test_file_path()), num_records_(num_records) {
     create_test_file();
   }
 
@@ -23,6 +35,7 @@ public:
 
 private:
   std::string path_;
+  int num_records_;
 
   void create_test_file() {
     std::ofstream file(path_, std::ios::binary);
@@ -32,8 +45,8 @@ private:
     metadata[0] = 1; // version
     file.write(reinterpret_cast<const char*>(metadata.data()), 200);
 
-    // Write 10 test MBO records (48 bytes each)
-    for (int i = 0; i < 10; ++i) {
+    // Write test MBO records (48 bytes each)
+    for (int i = 0; i < num_records_; ++i) {
       databento::MboMsg msg{};
       msg.ts_event = 1000000000ULL + i * 1000;
       msg.instrument_id = 1234 + i;
@@ -55,6 +68,66 @@ private:
   }
 };
 
+// ============================================================================
+// Test Helper: Wrap a file in zstd frames (raw blocks, no libzstd needed)
+// ============================================================================
+
+class TestZstdFile {
+public:
+  // A nonzero declared_first replaces the first frame's content size (in
+  // the 8-byte header field), as a corrupt file would
+  TestZstdFile(const std::string& source, size_t num_frames, uint64_t declared_first = 0)
+      : path_(test_file_path(".dbn.zst")) {
+    std::ifstream in(source, std::ios::binary);
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(in)),
+                                 std::istreambuf_iterator<char>());
+
+    std::ofstream out(path_, std::ios::binary);
+    const size_t frame_size = (content.size() + num_frames - 1) / num_frames;
+    for (size_t pos = 0; pos < content.size(); pos += frame_size) {
+      write_frame(out, content.data() + pos, std::min(frame_size, content.size() - pos),
+                  pos == 0 ? declared_first : 0);
+    }
+  }
+
+  ~TestZstdFile() {
+    std::remove(path_.c_str());
+  }
+
+  const std::string& path() const { return path_; }
+
+private:
+  std::string path_;
+
+  static void write_le(std::ofstream& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+      out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+  }
+
+  static void write_frame(std::ofstream& out, const uint8_t* data, size_t size,
+                          uint64_t declared) {
+    write_le(out, databento::ZSTD_FRAME_MAGIC, 4);
+    if (declared != 0) {
+      out.put(static_cast<char>(0xE0)); // Single segment, 8-byte content size
+      write_le(out, declared, 8);
+    } else {
+      out.put(static_cast<char>(0xA0)); // Single segment, 4-byte content size
+      write_le(out, size, 4);
+    }
+
+    constexpr size_t max_block = 128 * 1024;
+    size_t pos = 0;
+    do {
+      const size_t block = std::min(max_block, size - pos);
+      const bool last = pos + block == size;
+      write_le(out, static_cast<uint32_t>((block << 3) | (last ? 1 : 0)), 3); // Raw block
+      out.write(reinterpret_cast<const char*>(data + pos), block);
+      pos += block;
+    } while (pos < size);
+  }
+};
+
 // ============================================================================
 // DbnParser Tests
 // ============================================================================
@@ -77,6 +150,50 @@ TEST(DbnParserTest, FileNotFound) {
   EXPECT_THROW(parser.load_into_memory(), std::runtime_error);
 }
 
+TEST(DbnParserTest, FailedReloadLeavesNoStaleRecords) {
+  TestDbnFile test_file;
+  databento::DbnParser parser(test_file.path());
+  parser.load_with_mmap();
+  ASSERT_EQ(parser.num_records(), 10);
+
+  // Shorter than the metadata: no records
+  {
+    std::ofstream file(test_file.path(), std::ios::binary | std::ios::trunc);
+    file.write("short", 5);
+  }
+  parser.load_into_memory();
+  EXPECT_EQ(parser.num_records(), 0);
+
+  // The old data is released before the failing open
+  std::remove(test_file.path().c_str());
+  EXPECT_THROW(parser.load_with_mmap(), std::runtime_error);
+  EXPECT_EQ(parser.data(), nullptr);
+  EXPECT_EQ(parser.num_records(), 0);
+  EXPECT_THROW(parser.get_record(0), std::out_of_range);
+}
+
+TEST(DbnParserTest, FailedAlternateLoadLeavesNoStaleRecords) {
+  const std::vector<std::function<void(databento::DbnParser&)>> loaders = {
+      [](databento::DbnParser& p) { p.load_parallel(); },
+      [](databento::DbnParser& p) { p.load_numa(); },
+      [](databento::DbnParser& p) { p.load_with_io_uring(); },
+      [](databento::DbnParser& p) { p.load_zstd(); },
+  };
+  for (size_t i = 0; i < loaders.size(); ++i) {
+    SCOPED_TRACE(i);
+    TestDbnFile test_file;
+    databento::DbnParser parser(test_file.path());
+    parser.load_with_mmap();
+    ASSERT_EQ(parser.num_records(), 10);
+
+    std::remove(test_file.path().c_str());
+    EXPECT_THROW(loaders[i](parser), std::runtime_error);
+    EXPECT_EQ(parser.data(), nullptr);
+    EXPECT_EQ(parser.num_records(), 0);
+    EXPECT_THROW(parser.get_record(0), std::out_of_range);
+  }
+}
+
 TEST(DbnParserTest, ParseMbo) {
   TestDbnFile test_file;
   
@@ -102,6 +219,48 @@ TEST(DbnParserTest, ParseMbo) {
   EXPECT_EQ(messages[9].side, 'A');
 }
 
+TEST(DbnParserTest, ParseMboInlinedFunctor) {
+  TestDbnFile test_file;
+
+  struct Summer {
+    uint64_t size_sum = 0;
+    uint64_t count = 0;
+    void operator()(const databento::MboMsg& msg) {
+      size_sum += msg.size;
+      ++count;
+    }
+  };
+
+  databento::DbnParser parser(test_file.path());
+  Summer summer;
+  parser.parse_mbo(summer);
+
+  EXPECT_EQ(summer.count, 10);
+  EXPECT_EQ(summer.size_sum, 1450); // 100 + 110 + ... + 190
+}
+
+TEST(DbnParserTest, ParseMboStdFunctionMatchesTemplate) {
+  TestDbnFile test_file;
+
+  databento::DbnParser parser(test_file.path());
+  parser.load_into_memory();
+
+  std::vector<uint64_t> via_function;
+  databento::MboCallback callback = [&](const databento::MboMsg& msg) {
+    via_function.push_back(msg.order_id);
+  };
+  parser.parse_mbo(callback);
+
+  std::vector<uint64_t> via_template;
+  parser.parse_mbo([&](const databento::MboMsg& msg) {
+    via_template.push_back(msg.order_id);
+  });
+
+  EXPECT_EQ(via_function, via_template);
+  ASSERT_EQ(via_template.size(), 10);
+  EXPECT_EQ(via_template[3], 10003);
+}
+
 TEST(DbnParserTest, DirectAccess) {
   TestDbnFile test_file;
   
@@ -153,6 +312,1163 @@ TEST(DbnParserTest, BatchAccess) {
   EXPECT_EQ(msg1.instrument_id, 1235);
 }
 
+// ============================================================================
+// Parallel Scan Tests
+// ============================================================================
+
+TEST(ParallelScanTest, PartitionCoversAllRecords) {
+  TestDbnFile test_file(10000);
+
+  databento::DbnParser parser(test_file.path());
+  parser.load_into_memory();
+
+  auto ranges = parser.partition(3);
+  ASSERT_EQ(ranges.size(), 3);
+  EXPECT_EQ(ranges.front().begin, 0);
+  EXPECT_EQ(ranges.back().end, 10000);
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    EXPECT_EQ(ranges[i].begin, ranges[i - 1].end);
+    EXPECT_EQ(ranges[i].begin % databento::DbnParser::PARALLEL_CHUNK_RECORDS, 0);
+  }
+}
+
+TEST(ParallelScanTest, ParallelSumMatchesSerial) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+  parser.load_into_memory();
+
+  uint64_t serial = 0;
+  parser.parse_mbo([&](const databento::MboMsg& msg) { serial += msg.size; });
+
+  for (size_t threads : {1, 2, 4, 7}) {
+    uint64_t parallel = parser.parallel_parse_mbo<uint64_t>(
+        threads,
+        [](uint64_t& acc, const databento::MboMsg& msg) { acc += msg.size; },
+        [](uint64_t& total, uint64_t& partial) { total += partial; });
+    EXPECT_EQ(parallel, serial) << "threads=" << threads;
+  }
+}
+
+TEST(ParallelScanTest, ReduceRunsInRangeOrder) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+
+  auto order_ids = parser.parallel_parse_mbo(
+      4,
+      [](std::vector<uint64_t>& acc, const databento::MboMsg& msg) {
+        acc.push_back(msg.order_id);
+      },
+      [](std::vector<uint64_t>& total, std::vector<uint64_t>& partial) {
+        total.insert(total.end(), partial.begin(), partial.end());
+      },
+      std::vector<uint64_t>{});
+
+  ASSERT_EQ(order_ids.size(), 20000);
+  EXPECT_TRUE(std::is_sorted(order_ids.begin(), order_ids.end()));
+}
+
+TEST(ParallelScanTest, WorkerExceptionPropagates) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+  parser.load_into_memory();
+
+  EXPECT_THROW(parser.parallel_for_ranges(4, [](size_t t, databento::RecordRange) {
+    if (t == 2) {
+      throw std::runtime_error("worker failed");
+    }
+  }), std::runtime_error);
+}
+
+TEST(ParallelScanTest, NumaTopologyCoversAllowedCpus) {
+  const auto& topology = databento::NumaTopology::system();
+
+  ASSERT_GE(topology.num_nodes(), 1u);
+  ASSERT_EQ(topology.node_ids.size(), topology.num_nodes());
+  for (size_t worker = 0; worker < 5; ++worker) {
+    const int cpu = topology.cpu_for_worker(worker, 5);
+    EXPECT_GE(topology.node_of_cpu(cpu), 0) << "worker " << worker;
+  }
+  // Workers take CPUs in node-major order
+  EXPECT_LE(topology.node_of_cpu(topology.cpu_for_worker(0, 2)),
+            topology.node_of_cpu(topology.cpu_for_worker(1, 2)));
+}
+
+TEST(ParallelScanTest, NumaLoadMatchesLoadIntoMemory) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+
+  for (bool interleave : {false, true}) {
+    databento::DbnParser parser(test_file.path());
+    parser.load_numa(3, interleave);
+
+    ASSERT_EQ(parser.size(), expected.size());
+    EXPECT_EQ(parser.num_records(), 20000u);
+    EXPECT_EQ(std::memcmp(parser.data(), expected.data(), expected.size()), 0);
+
+    const auto& placement = parser.numa_placement();
+    ASSERT_EQ(placement.size(), 3u);
+    const auto ranges = parser.partition(3);
+    for (size_t t = 0; t < placement.size(); ++t) {
+      EXPECT_EQ(placement[t].range.begin, ranges[t].begin);
+      EXPECT_EQ(placement[t].range.end, ranges[t].end);
+      EXPECT_EQ(placement[t].node, databento::NumaTopology::system().node_of_cpu(placement[t].cpu));
+    }
+
+    // Scans with the same thread count reuse the placement
+    uint64_t parallel = parser.parallel_parse_mbo<uint64_t>(
+        3,
+        [](uint64_t& acc, const databento::MboMsg& msg) { acc += msg.size; },
+        [](uint64_t& total, uint64_t& partial) { total += partial; });
+    uint64_t serial = 0;
+    expected.parse_mbo([&](const databento::MboMsg& msg) { serial += msg.size; });
+    EXPECT_EQ(parallel, serial);
+  }
+
+  databento::DbnParser reloaded(test_file.path());
+  reloaded.load_numa(2);
+  reloaded.load_into_memory();
+  EXPECT_TRUE(reloaded.numa_placement().empty());
+}
+
+// ============================================================================
+// Time Seek Tests
+// ============================================================================
+
+// Write a DBN file whose records carry the given ts_event values
+static void write_ts_file(const std::string& path, const std::vector<uint64_t>& timestamps) {
+  std::vector<databento::MboMsg> records(timestamps.size());
+  for (size_t i = 0; i < timestamps.size(); ++i) {
+    records[i].ts_event = timestamps[i];
+    records[i].order_id = i;
+  }
+  write_dbn_file(path, records);
+}
+
+static std::vector<uint64_t> collect_range(databento::DbnParser& parser, uint64_t t0, uint64_t t1) {
+  std::vector<uint64_t> order_ids;
+  parser.parse_mbo_range(t0, t1, [&](const databento::MboMsg& msg) {
+    order_ids.push_back(msg.order_id);
+  });
+  return order_ids;
+}
+
+static std::vector<uint64_t> expected_range(const std::vector<uint64_t>& timestamps,
+                                            uint64_t t0, uint64_t t1) {
+  std::vector<uint64_t> order_ids;
+  for (size_t i = 0; i < timestamps.size(); ++i) {
+    if (timestamps[i] >= t0 && timestamps[i] < t1) {
+      order_ids.push_back(i);
+    }
+  }
+  return order_ids;
+}
+
+TEST(TimeSeekTest, LowerBoundMatchesStd) {
+  // Bursty timestamps with duplicates, so interpolation guesses miss
+  std::vector<uint64_t> timestamps;
+  uint64_t ts = 1'000'000;
+  for (size_t i = 0; i < 50000; ++i) {
+    ts += (i % 1000 == 0) ? 5'000'000 : (i % 3);
+    timestamps.push_back(ts);
+  }
+  const std::string path = test_file_path();
+  write_ts_file(path, timestamps);
+
+  databento::DbnParser parser(path);
+  for (uint64_t probe : {uint64_t{0}, timestamps.front(), timestamps[12345], timestamps[12345] + 1,
+                         timestamps[30000] - 1, timestamps.back(), timestamps.back() + 1}) {
+    const size_t expected = std::lower_bound(timestamps.begin(), timestamps.end(), probe) -
+                            timestamps.begin();
+    EXPECT_EQ(parser.lower_bound_time(probe), expected) << "ts=" << probe;
+  }
+  EXPECT_EQ(parser.io_backend(), databento::IoBackend::Mmap);
+
+  // The index gives the same answers for sorted input
+  const auto& index = parser.build_time_index(1000);
+  EXPECT_TRUE(index.sorted);
+  EXPECT_EQ(index.num_blocks(), 50);
+  EXPECT_EQ(parser.lower_bound_time(timestamps[12345]),
+            std::lower_bound(timestamps.begin(), timestamps.end(), timestamps[12345]) -
+                timestamps.begin());
+  std::remove(path.c_str());
+}
+
+TEST(TimeSeekTest, RangeScanSorted) {
+  TestDbnFile test_file(1000);
+  databento::DbnParser parser(test_file.path());
+
+  // ts_event = 1e9 + i * 1000; [t0, t1) is half-open
+  auto ids = collect_range(parser, 1000000000ULL + 100 * 1000, 1000000000ULL + 200 * 1000);
+  ASSERT_EQ(ids.size(), 100);
+  EXPECT_EQ(ids.front(), 10000ULL + 100);
+  EXPECT_EQ(ids.back(), 10000ULL + 199);
+
+  EXPECT_TRUE(collect_range(parser, 5, 5).empty());
+  EXPECT_TRUE(collect_range(parser, 0, 1000000000ULL).empty());
+  EXPECT_EQ(collect_range(parser, 0, UINT64_MAX).size(), 1000);
+}
+
+TEST(TimeSeekTest, IndexedRangeScanUnsorted) {
+  // Roughly ordered: each timestamp jitters around its position
+  std::vector<uint64_t> timestamps;
+  uint64_t state = 42;
+  for (size_t i = 0; i < 20000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    timestamps.push_back(1'000'000 + i * 100 + (state >> 33) % 5000);
+  }
+  const std::string path = test_file_path();
+  write_ts_file(path, timestamps);
+
+  databento::DbnParser parser(path);
+  EXPECT_EQ(parser.time_index(), nullptr);
+  const auto& index = parser.build_time_index(256);
+  EXPECT_FALSE(index.sorted);
+  ASSERT_EQ(parser.time_index(), &index);
+
+  const uint64_t t0 = 1'000'000 + 5000 * 100;
+  const uint64_t t1 = 1'000'000 + 9000 * 100;
+  EXPECT_EQ(collect_range(parser, t0, t1), expected_range(timestamps, t0, t1));
+
+  // Segments skip blocks entirely outside the window
+  auto segments = parser.time_segments(t0, t1);
+  ASSERT_FALSE(segments.empty());
+  EXPECT_GT(segments.front().range.begin, 0);
+  EXPECT_LT(segments.back().range.end, timestamps.size());
+
+  const size_t first = std::find_if(timestamps.begin(), timestamps.end(),
+                                    [&](uint64_t ts) { return ts >= t0; }) - timestamps.begin();
+  EXPECT_EQ(parser.lower_bound_time(t0), first);
+  EXPECT_EQ(parser.lower_bound_time(UINT64_MAX), timestamps.size());
+  std::remove(path.c_str());
+}
+
+TEST(TimeSeekTest, ReloadDropsIndex) {
+  const std::string path = test_file_path();
+  std::vector<uint64_t> timestamps;
+  for (size_t i = 0; i < 20000; ++i) {
+    timestamps.push_back(1'000'000 + (i ^ 7) * 100);
+  }
+  write_ts_file(path, timestamps);
+  databento::DbnParser parser(path);
+  parser.load_into_memory();
+  parser.build_time_index(256);
+
+  // A shorter file in its place: the old block layout must not survive
+  timestamps.resize(1000);
+  write_ts_file(path, timestamps);
+  parser.load_into_memory();
+  EXPECT_EQ(parser.time_index(), nullptr);
+  EXPECT_EQ(collect_range(parser, 0, UINT64_MAX), expected_range(timestamps, 0, UINT64_MAX));
+  EXPECT_EQ(parser.lower_bound_time(UINT64_MAX), timestamps.size());
+  std::remove(path.c_str());
+}
+
+// ============================================================================
+// Instrument Index Tests
+// ============================================================================
+
+// Records cycle through instruments unevenly, with some long runs
+static std::vector<uint32_t> write_instrument_file(const std::string& path, size_t count) {
+  std::vector<uint32_t> ids;
+  std::vector<databento::MboMsg> records(count);
+  for (size_t i = 0; i < count; ++i) {
+    records[i].ts_event = 1000 + i;
+    records[i].instrument_id = (i / 500) % 2 == 0 ? static_cast<uint32_t>((i * i) % 37) : 99;
+    records[i].order_id = i;
+    ids.push_back(records[i].instrument_id);
+  }
+  write_dbn_file(path, records);
+  return ids;
+}
+
+TEST(InstrumentIndexTest, ParseInstrumentMatchesFullScan) {
+  const std::string path = test_file_path();
+  const std::string sidecar = databento::InstrumentIndex::sidecar_path(path);
+  std::remove(sidecar.c_str());
+  auto ids = write_instrument_file(path, 20000);
+
+  databento::DbnParser parser(path);
+  const auto& index = parser.instrument_index(false);
+  EXPECT_EQ(index.num_records(), 20000);
+  EXPECT_EQ(index.count(12345), 0);
+
+  size_t total = 0;
+  for (uint32_t id : index.instruments()) {
+    std::vector<uint64_t> order_ids;
+    parser.parse_mbo_instrument(id, [&](const databento::MboMsg& msg) {
+      EXPECT_EQ(msg.instrument_id, id);
+      order_ids.push_back(msg.order_id);
+    });
+
+    std::vector<uint64_t> expected;
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (ids[i] == id) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(order_ids, expected) << "instrument " << id;
+    EXPECT_EQ(index.records(id), expected);
+    total += order_ids.size();
+  }
+  EXPECT_EQ(total, 20000);
+
+  // persist = false leaves no sidecar behind
+  std::ifstream missing(sidecar);
+  EXPECT_FALSE(missing.good());
+  std::remove(path.c_str());
+}
+
+TEST(InstrumentIndexTest, ReloadDropsIndex) {
+  const std::string path = test_file_path();
+  write_instrument_file(path, 3000);
+  databento::DbnParser parser(path);
+  parser.load_into_memory();
+  EXPECT_EQ(parser.instrument_index(false).count(99), 1500);
+
+  // A changed file in its place: offsets into the old one must not survive
+  write_instrument_file(path, 1000);
+  parser.load_into_memory();
+  const auto& index = parser.instrument_index(false);
+  EXPECT_EQ(index.num_records(), 1000);
+  EXPECT_EQ(index.count(99), 500);
+  std::remove(path.c_str());
+}
+
+TEST(InstrumentIndexTest, SidecarIsReusedAndInvalidated) {
+  const std::string path = test_file_path();
+  const std::string sidecar = databento::InstrumentIndex::sidecar_path(path);
+  std::remove(sidecar.c_str());
+  write_instrument_file(path, 3000);
+
+  {
+    databento::DbnParser parser(path);
+    EXPECT_EQ(parser.instrument_index().count(99), 1500);
+  }
+  std::ifstream written(sidecar, std::ios::binary);
+  ASSERT_TRUE(written.good());
+
+  struct stat sb;
+  ASSERT_EQ(stat(path.c_str(), &sb), 0);
+  const int64_t mtime_ns = static_cast<int64_t>(sb.st_mtim.tv_sec) * 1'000'000'000 + sb.st_mtim.tv_nsec;
+  auto loaded = databento::InstrumentIndex::load(sidecar, sb.st_size, mtime_ns, 3000);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->count(99), 1500);
+
+  // A rewritten source no longer matches the stored size
+  EXPECT_FALSE(databento::InstrumentIndex::load(sidecar, sb.st_size + 48, mtime_ns, 3000).has_value());
+  EXPECT_FALSE(databento::InstrumentIndex::load(sidecar, sb.st_size, mtime_ns, 2999).has_value());
+  write_instrument_file(path, 1000);
+  databento::DbnParser parser(path);
+  EXPECT_EQ(parser.instrument_index().num_records(), 1000);
+  EXPECT_EQ(parser.instrument_index().count(99), 500);
+
+  std::remove(sidecar.c_str());
+  std::remove(path.c_str());
+}
+
+TEST(InstrumentIndexTest, CorruptSidecarIsRebuilt) {
+  const std::string path = test_file_path();
+  const std::string sidecar = databento::InstrumentIndex::sidecar_path(path);
+  std::remove(sidecar.c_str());
+  const auto ids = write_instrument_file(path, 3000);
+  {
+    databento::DbnParser parser(path);
+    parser.instrument_index();
+  }
+
+  std::ifstream in(sidecar, std::ios::binary);
+  const std::vector<char> original((std::istreambuf_iterator<char>(in)),
+                                   std::istreambuf_iterator<char>());
+  in.close();
+  ASSERT_GT(original.size(), 56u);
+
+  struct stat sb;
+  ASSERT_EQ(stat(path.c_str(), &sb), 0);
+  const int64_t mtime_ns = static_cast<int64_t>(sb.st_mtim.tv_sec) * 1'000'000'000 + sb.st_mtim.tv_nsec;
+  const auto write_sidecar = [&](const std::vector<char>& bytes) {
+    std::ofstream out(sidecar, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  };
+
+  // Header counts claiming more than the file holds are rejected before
+  // anything is allocated for them
+  for (size_t field : {size_t{12}, size_t{40}}) {
+    auto corrupt = original;
+    std::memset(corrupt.data() + field, 0xFF, field == 12 ? 4 : 8);
+    write_sidecar(corrupt);
+    EXPECT_FALSE(databento::InstrumentIndex::load(sidecar, sb.st_size, mtime_ns, 3000).has_value())
+        << "field at " << field;
+  }
+
+  // Any damaged byte is rejected, and the parser rebuilds a correct index
+  for (size_t pos = 0; pos < original.size(); pos += pos < 300 ? 1 : 7) {
+    auto corrupt = original;
+    corrupt[pos] = static_cast<char>(corrupt[pos] ^ 0x5A);
+    write_sidecar(corrupt);
+    ASSERT_FALSE(databento::InstrumentIndex::load(sidecar, sb.st_size, mtime_ns, 3000).has_value())
+        << "byte " << pos;
+
+    databento::DbnParser parser(path);
+    const auto& index = parser.instrument_index();
+    ASSERT_EQ(index.num_records(), 3000u) << "byte " << pos;
+    for (uint32_t id : {0u, 1u, 99u}) {
+      std::vector<uint64_t> expected;
+      for (size_t i = 0; i < ids.size(); ++i) {
+        if (ids[i] == id) {
+          expected.push_back(i);
+        }
+      }
+      ASSERT_EQ(index.records(id), expected) << "byte " << pos << " instrument " << id;
+    }
+  }
+
+  std::remove(sidecar.c_str());
+  std::remove(path.c_str());
+}
+
+// ============================================================================
+// MBP Record Tests
+// ============================================================================
+
+// MBP-10 file whose level l of record i carries recognisable values
+static void write_mbp10_file(const std::string& path, size_t count) {
+  std::vector<databento::Mbp10Msg> records(count);
+  for (size_t i = 0; i < count; ++i) {
+    databento::Mbp10Msg& msg = records[i];
+    msg.ts_event = 1000 + i;
+    msg.instrument_id = 7;
+    msg.action = 'A';
+    msg.sequence = static_cast<uint32_t>(i);
+    for (size_t l = 0; l < 10; ++l) {
+      msg.levels[l].bid_px = 1000 - static_cast<int64_t>(l);
+      msg.levels[l].ask_px = 1001 + static_cast<int64_t>(l);
+      msg.levels[l].bid_sz = static_cast<uint32_t>(i + l);
+      msg.levels[l].ask_sz = static_cast<uint32_t>(2 * i + l);
+    }
+  }
+  write_dbn_file(path, records);
+}
+
+TEST(MbpTest, ParseMbp10) {
+  const std::string path = test_file_path();
+  write_mbp10_file(path, 1000);
+
+  databento::DbnParser parser(path, databento::RType::Mbp10);
+  EXPECT_EQ(parser.record_size(), 368);
+  size_t n = 0;
+  parser.parse_mbp10([&](const databento::Mbp10Msg& msg) {
+    EXPECT_EQ(msg.sequence, n);
+    EXPECT_EQ(msg.levels[9].ask_px, 1010);
+    EXPECT_EQ(msg.levels[3].bid_sz, n + 3);
+    ++n;
+  });
+  EXPECT_EQ(n, 1000);
+
+  // Streaming gives the same records, windows cutting through records
+  databento::DbnStream stream(path, 64 * 1024, databento::IoBackend::Pread, databento::RType::Mbp10);
+  size_t streamed = 0;
+  stream.parse_mbp10([&](const databento::Mbp10Msg& msg) {
+    EXPECT_EQ(msg.sequence, streamed++);
+  });
+  EXPECT_EQ(streamed, 1000);
+  std::remove(path.c_str());
+}
+
+TEST(MbpTest, SchemaMismatchThrows) {
+  TestDbnFile test_file(10);
+  databento::DbnParser parser(test_file.path());
+  EXPECT_THROW(parser.parse_mbp10([](const databento::Mbp10Msg&) {}), std::runtime_error);
+
+  databento::BatchProcessor processor;
+  EXPECT_THROW(processor.process_batch_spans<databento::Mbp1Msg>(
+                   parser, [](std::span<const databento::Mbp1Msg>) {}),
+               std::runtime_error);
+  EXPECT_THROW(databento::DbnParser(test_file.path(), databento::RType::Ohlcv1S),
+               std::invalid_argument);
+}
+
+TEST(MbpTest, BatchesAndLadders) {
+  const std::string path = test_file_path();
+  write_mbp10_file(path, 2500);
+
+  databento::DbnParser parser(path, databento::RType::Mbp10);
+  databento::BatchProcessor processor(1000);
+
+  size_t spans = 0;
+  processor.process_batch_spans<databento::Mbp10Msg>(parser, [&](std::span<const databento::Mbp10Msg> batch) {
+    EXPECT_EQ(batch.front().sequence, spans * 1000);
+    ++spans;
+  });
+  EXPECT_EQ(spans, 3);
+
+  // Depth imbalance over the top 5 levels, per record
+  std::vector<double> imbalance;
+  processor.process_ladders(parser, 5, [&](const databento::MbpLadders& ladders) {
+    for (size_t i = 0; i < ladders.count; ++i) {
+      double bid = 0;
+      double ask = 0;
+      for (size_t l = 0; l < ladders.levels; ++l) {
+        bid += ladders.at(ladders.bid_sz, l)[i];
+        ask += ladders.at(ladders.ask_sz, l)[i];
+      }
+      imbalance.push_back(bid + ask > 0 ? (bid - ask) / (bid + ask) : 0.0);
+    }
+  });
+  ASSERT_EQ(imbalance.size(), 2500);
+  // Record 10: bid sizes 10..14 (60), ask sizes 20..24 (110)
+  EXPECT_DOUBLE_EQ(imbalance[10], (60.0 - 110.0) / 170.0);
+  std::remove(path.c_str());
+}
+
+// ============================================================================
+// Streaming Reader Tests
+// ============================================================================
+
+TEST(DbnStreamTest, MatchesInMemoryParse) {
+  TestDbnFile test_file(5000);
+
+  databento::DbnParser parser(test_file.path());
+  std::vector<uint64_t> expected;
+  parser.parse_mbo([&](const databento::MboMsg& msg) { expected.push_back(msg.order_id); });
+
+  // 1000-byte budget gives 452-byte windows, so records straddle edges
+  databento::DbnStream stream(test_file.path(), 1000);
+  EXPECT_EQ(stream.window_bytes() % 48, 20);
+
+  std::vector<uint64_t> streamed;
+  stream.parse_mbo([&](const databento::MboMsg& msg) { streamed.push_back(msg.order_id); });
+
+  EXPECT_EQ(stream.num_records(), 5000);
+  EXPECT_EQ(streamed, expected);
+}
+
+TEST(DbnStreamTest, RewindReparses) {
+  TestDbnFile test_file(300);
+
+  databento::DbnStream stream(test_file.path(), 4096);
+
+  uint64_t first = 0;
+  stream.parse_mbo([&](const databento::MboMsg& msg) { first += msg.size; });
+
+  uint64_t second = 0;
+  stream.parse_mbo([&](const databento::MboMsg& msg) { second += msg.size; });
+
+  EXPECT_EQ(first, second);
+  EXPECT_GT(first, 0);
+}
+
+TEST(DbnStreamTest, FileNotFound) {
+  databento::DbnStream stream("/nonexistent/file.dbn");
+
+  EXPECT_THROW(stream.open(), std::runtime_error);
+}
+
+TEST(DbnStreamTest, BatchesSpanWindows) {
+  TestDbnFile test_file(1000);
+
+  databento::DbnStream stream(test_file.path(), 2000);
+  databento::BatchProcessor batch_proc(300);
+
+  std::vector<size_t> batch_sizes;
+  uint64_t next_order_id = 10000;
+  batch_proc.process_batches<databento::MboMsg>(stream,
+      [&](const std::vector<databento::MboMsg>& batch) {
+        batch_sizes.push_back(batch.size());
+        for (const auto& msg : batch) {
+          EXPECT_EQ(msg.order_id, next_order_id++);
+        }
+      });
+
+  EXPECT_EQ(batch_sizes, (std::vector<size_t>{300, 300, 300, 100}));
+}
+
+// ============================================================================
+// io_uring Loader Tests
+// ============================================================================
+
+TEST(IoUringLoadTest, MatchesLoadIntoMemory) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+
+  databento::DbnParser parser(test_file.path());
+  parser.load_with_io_uring(8, 4096);
+
+  EXPECT_TRUE(parser.io_backend() == databento::IoBackend::IoUring ||
+              parser.io_backend() == databento::IoBackend::Pread);
+  ASSERT_EQ(parser.size(), expected.size());
+  EXPECT_EQ(parser.num_records(), 20000);
+  EXPECT_EQ(std::memcmp(parser.data(), expected.data(), parser.size()), 0);
+}
+
+TEST(IoUringLoadTest, RecordsReadyInFileOrder) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+
+  size_t next = 0;
+  size_t callbacks = 0;
+  parser.load_with_io_uring(4, 8192, [&](databento::RecordRange range) {
+    EXPECT_EQ(range.begin, next);
+    // Records reported ready must already be in the buffer
+    for (size_t i = range.begin; i < range.end; ++i) {
+      EXPECT_EQ(databento::parse_mbo(parser.get_record(i)).order_id, 10000 + i);
+    }
+    next = range.end;
+    ++callbacks;
+  });
+
+  EXPECT_EQ(next, 20000);
+  EXPECT_GT(callbacks, 1);
+}
+
+TEST(IoUringLoadTest, FileNotFound) {
+  databento::DbnParser parser("/nonexistent/file.dbn");
+
+  EXPECT_THROW(parser.load_with_io_uring(), std::runtime_error);
+}
+
+TEST(IoUringLoadTest, StreamBackendMatchesPread) {
+  TestDbnFile test_file(5000);
+
+  databento::DbnStream pread_stream(test_file.path(), 8192);
+  std::vector<uint64_t> expected;
+  pread_stream.parse_mbo([&](const databento::MboMsg& msg) { expected.push_back(msg.order_id); });
+
+  databento::DbnStream uring_stream(test_file.path(), 8192, databento::IoBackend::IoUring);
+  std::vector<uint64_t> streamed;
+  uring_stream.parse_mbo([&](const databento::MboMsg& msg) { streamed.push_back(msg.order_id); });
+
+  EXPECT_EQ(streamed, expected);
+  EXPECT_EQ(uring_stream.io_backend() == databento::IoBackend::IoUring,
+            databento::IoUring::supported());
+}
+
+// ============================================================================
+// Direct I/O Stream Tests
+// ============================================================================
+
+namespace {
+
+std::vector<uint64_t> stream_order_ids(const std::string& path, size_t budget,
+                                       databento::IoBackend backend) {
+  databento::DbnStream stream(path, budget, backend);
+  std::vector<uint64_t> ids;
+  stream.parse_mbo([&](const databento::MboMsg& msg) { ids.push_back(msg.order_id); });
+  return ids;
+}
+
+// Pages of the file currently in the page cache
+size_t resident_pages(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  struct stat sb;
+  fstat(fd, &sb);
+  void* addr = mmap(nullptr, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  const size_t page = sysconf(_SC_PAGESIZE);
+  std::vector<unsigned char> pages((sb.st_size + page - 1) / page);
+  mincore(addr, sb.st_size, pages.data());
+  munmap(addr, sb.st_size);
+  close(fd);
+  return std::count_if(pages.begin(), pages.end(), [](unsigned char p) { return p & 1; });
+}
+
+// Write back and evict the file's cached pages. Returns false if any stay.
+bool drop_page_cache(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  fdatasync(fd);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+  return resident_pages(path) == 0;
+}
+
+} // namespace
+
+TEST(DirectStreamTest, MatchesPread) {
+  for (int records : {10, 5000, 20000}) {
+    TestDbnFile test_file(records);
+    for (size_t budget : {size_t{1000}, size_t{20000}, size_t{64 * 1024},
+                          databento::DbnStream::DEFAULT_MEMORY_BUDGET}) {
+      const auto expected = stream_order_ids(test_file.path(), budget, databento::IoBackend::Pread);
+      const auto streamed = stream_order_ids(test_file.path(), budget, databento::IoBackend::Direct);
+      ASSERT_EQ(expected.size(), static_cast<size_t>(records));
+      EXPECT_EQ(streamed, expected) << "records=" << records << " budget=" << budget;
+    }
+  }
+}
+
+TEST(DirectStreamTest, IgnoresTrailingPartialRecord) {
+  TestDbnFile test_file(3000);
+  {
+    std::ofstream file(test_file.path(), std::ios::binary | std::ios::app);
+    file.write("partial", 7);
+  }
+
+  databento::DbnStream stream(test_file.path(), 16384, databento::IoBackend::Direct);
+  stream.open();
+  EXPECT_EQ(stream.num_records(), 3000u);
+  EXPECT_EQ(stream.window_bytes() % databento::DIRECT_IO_ALIGNMENT, 0u);
+
+  // Twice: parse_mbo rewinds to the metadata block
+  for (int pass = 0; pass < 2; ++pass) {
+    std::vector<uint64_t> ids;
+    stream.parse_mbo([&](const databento::MboMsg& msg) { ids.push_back(msg.order_id); });
+    ASSERT_EQ(ids.size(), 3000u);
+    for (size_t i = 0; i < ids.size(); ++i) {
+      ASSERT_EQ(ids[i], 10000 + i);
+    }
+  }
+  EXPECT_TRUE(stream.io_backend() == databento::IoBackend::Direct ||
+              stream.io_backend() == databento::IoBackend::Pread);
+}
+
+TEST(DirectStreamTest, BypassesPageCache) {
+  TestDbnFile test_file(50000);
+  if (!drop_page_cache(test_file.path())) {
+    GTEST_SKIP() << "Page cache could not be dropped for the test file";
+  }
+
+  databento::DbnStream stream(test_file.path(), 64 * 1024, databento::IoBackend::Direct);
+  size_t count = 0;
+  stream.parse_mbo([&](const databento::MboMsg&) { ++count; });
+  if (stream.io_backend() != databento::IoBackend::Direct) {
+    GTEST_SKIP() << "Filesystem does not support O_DIRECT";
+  }
+
+  EXPECT_EQ(count, 50000u);
+  EXPECT_EQ(resident_pages(test_file.path()), 0u);
+}
+
+// ============================================================================
+// Parallel Loader Tests
+// ============================================================================
+
+TEST(ParallelLoadTest, MatchesLoadIntoMemory) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+
+  for (size_t threads : {1, 3, 8}) {
+    for (size_t chunk_bytes : {size_t{1}, size_t{1000}, size_t{65536},
+                               databento::DbnParser::DEFAULT_PARALLEL_CHUNK_BYTES}) {
+      databento::DbnParser parser(test_file.path());
+      parser.load_parallel(threads, chunk_bytes);
+
+      EXPECT_EQ(parser.io_backend(), databento::IoBackend::Pread);
+      ASSERT_EQ(parser.size(), expected.size());
+      EXPECT_EQ(parser.num_records(), 20000u);
+      EXPECT_EQ(std::memcmp(parser.data(), expected.data(), parser.size()), 0)
+          << "threads=" << threads << " chunk_bytes=" << chunk_bytes;
+    }
+  }
+}
+
+TEST(ParallelLoadTest, RecordsReadyInFileOrder) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+
+  size_t next = 0;
+  parser.load_parallel(4, 4800, [&](databento::RecordRange range) {
+    EXPECT_EQ(range.begin, next);
+    for (size_t i = range.begin; i < range.end; ++i) {
+      EXPECT_EQ(databento::parse_mbo(parser.get_record(i)).order_id, 10000 + i);
+    }
+    next = range.end;
+  });
+
+  EXPECT_EQ(next, 20000u);
+}
+
+TEST(ParallelLoadTest, SingleWorkerReportsEachChunk) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+
+  // One worker finishes chunks in file order, so each extends the prefix
+  size_t next = 0;
+  size_t callbacks = 0;
+  parser.load_parallel(1, 4800, [&](databento::RecordRange range) {
+    EXPECT_EQ(range.begin, next);
+    EXPECT_EQ(range.end - range.begin, 100u);
+    next = range.end;
+    ++callbacks;
+  });
+
+  EXPECT_EQ(next, 20000u);
+  EXPECT_EQ(callbacks, 200u);
+}
+
+TEST(ParallelLoadTest, KeepsTrailingPartialRecord) {
+  TestDbnFile test_file(1000);
+  {
+    std::ofstream file(test_file.path(), std::ios::binary | std::ios::app);
+    file.write("partial", 7);
+  }
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+  databento::DbnParser parser(test_file.path());
+  parser.load_parallel(3, 4800);
+
+  ASSERT_EQ(parser.size(), expected.size());
+  EXPECT_EQ(parser.num_records(), 1000u);
+  EXPECT_EQ(std::memcmp(parser.data(), expected.data(), parser.size()), 0);
+}
+
+TEST(ParallelLoadTest, CallbackExceptionPropagates) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser parser(test_file.path());
+  EXPECT_THROW(parser.load_parallel(4, 4800, [](databento::RecordRange range) {
+    if (range.end > 5000) {
+      throw std::runtime_error("consumer failed");
+    }
+  }), std::runtime_error);
+  EXPECT_EQ(parser.data(), nullptr);
+  EXPECT_EQ(parser.num_records(), 0u);
+}
+
+TEST(ParallelLoadTest, FileNotFound) {
+  databento::DbnParser parser("/nonexistent/file.dbn");
+
+  EXPECT_THROW(parser.load_parallel(), std::runtime_error);
+}
+
+// ============================================================================
+// Huge Page Tests
+// ============================================================================
+
+TEST(HugePageTest, AllocationIsAlignedAndZeroed) {
+  const auto pages = databento::allocate_pages(3 * 1024 * 1024, databento::HugePages::HugeTlb);
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(pages.addr) % databento::HUGE_PAGE_SIZE, 0u);
+  EXPECT_EQ(pages.bytes, 2 * databento::HUGE_PAGE_SIZE);
+  EXPECT_NE(pages.backing, databento::PageBacking::Heap);
+  const auto* bytes = static_cast<const uint8_t*>(pages.addr);
+  EXPECT_TRUE(std::all_of(bytes, bytes + pages.bytes, [](uint8_t b) { return b == 0; }));
+  databento::free_pages(pages);
+}
+
+TEST(HugePageTest, AlignedBufferUsesPagesAboveThreshold) {
+  databento::AlignedBuffer<uint64_t> small(databento::HugePages::Transparent);
+  small.resize(1024);
+  EXPECT_EQ(small.backing(), databento::PageBacking::Heap);
+
+  databento::AlignedBuffer<uint64_t> large(databento::HugePages::Transparent);
+  large.resize(databento::HUGE_PAGE_SIZE / sizeof(uint64_t));
+  EXPECT_NE(large.backing(), databento::PageBacking::Heap);
+  std::fill(large.begin(), large.end(), 7);
+
+  databento::AlignedBuffer<uint64_t> moved(std::move(large));
+  EXPECT_EQ(moved[0], 7u);
+  EXPECT_EQ(large.data(), nullptr);
+}
+
+TEST(HugePageTest, LoadsMatchRegularPages) {
+  TestDbnFile test_file(50000); // 2.4MB, above HUGE_PAGE_SIZE
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+  EXPECT_EQ(expected.page_backing(), databento::PageBacking::Heap);
+
+  databento::DbnParser in_memory(test_file.path());
+  in_memory.set_huge_pages(databento::HugePages::Transparent);
+  in_memory.load_into_memory();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(in_memory.data()) % databento::HUGE_PAGE_SIZE, 0u);
+  EXPECT_NE(in_memory.page_backing(), databento::PageBacking::Heap);
+  ASSERT_EQ(in_memory.size(), expected.size());
+  EXPECT_EQ(std::memcmp(in_memory.data(), expected.data(), expected.size()), 0);
+
+  databento::DbnParser mapped(test_file.path());
+  mapped.set_huge_pages(databento::HugePages::HugeTlb);
+  mapped.load_with_mmap();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped.data()) % databento::HUGE_PAGE_SIZE, 0u);
+  EXPECT_NE(mapped.page_backing(), databento::PageBacking::HugeTlb); // Files can't use hugetlb
+  EXPECT_EQ(std::memcmp(mapped.data(), expected.data(), expected.size()), 0);
+
+  databento::DbnParser uring(test_file.path());
+  uring.set_huge_pages(databento::HugePages::Transparent);
+  uring.load_with_io_uring(8, 65536);
+  EXPECT_EQ(std::memcmp(uring.data(), expected.data(), expected.size()), 0);
+}
+
+TEST(HugePageTest, StatsReportBacking) {
+  TestDbnFile test_file(50000);
+
+  uint64_t count = 0;
+  auto stats = databento::parse_file_mbo(test_file.path(),
+      [&count](const databento::MboMsg&) { ++count; }, false,
+      databento::HugePages::Transparent);
+
+  EXPECT_EQ(count, 50000u);
+  EXPECT_NE(stats.page_backing, databento::PageBacking::Heap);
+  EXPECT_LE(stats.huge_page_bytes, 2 * databento::HUGE_PAGE_SIZE);
+}
+
+// ============================================================================
+// Sliding-Window Mmap Tests
+// ============================================================================
+
+TEST(MmapWindowTest, MatchesInMemoryParse) {
+  TestDbnFile test_file(20000);
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+  std::vector<uint64_t> expected_ids;
+  expected.parse_mbo([&](const databento::MboMsg& msg) { expected_ids.push_back(msg.order_id); });
+
+  for (size_t window : {size_t{1}, size_t{4096}, size_t{100000},
+                        databento::DbnParser::DEFAULT_MMAP_WINDOW_BYTES}) {
+    databento::DbnParser parser(test_file.path());
+    parser.set_mmap_window(window);
+    parser.load_with_mmap();
+
+    // Twice: the second scan restarts the window behind the first
+    for (int pass = 0; pass < 2; ++pass) {
+      std::vector<uint64_t> ids;
+      parser.parse_mbo([&](const databento::MboMsg& msg) { ids.push_back(msg.order_id); });
+      EXPECT_EQ(ids, expected_ids) << "window=" << window;
+    }
+
+    databento::BatchProcessor processor;
+    processor.set_batch_size(1000);
+    uint64_t sum = 0;
+    processor.process_batch_spans<databento::MboMsg>(
+        parser, [&](std::span<const databento::MboMsg> batch) {
+          for (const auto& msg : batch) {
+            sum += msg.order_id;
+          }
+        });
+    EXPECT_EQ(sum, std::accumulate(expected_ids.begin(), expected_ids.end(), uint64_t{0}));
+
+    // Dropped pages fault back in from the file
+    EXPECT_EQ(databento::parse_mbo(parser.get_record(0)).order_id, 10000u);
+  }
+}
+
+TEST(MmapWindowTest, ResidentStaysBounded) {
+  TestDbnFile test_file(200000);
+  if (!drop_page_cache(test_file.path())) {
+    GTEST_SKIP() << "Page cache could not be dropped for the test file";
+  }
+
+  constexpr size_t WINDOW = 256 * 1024;
+  databento::DbnParser parser(test_file.path());
+  parser.set_mmap_window(WINDOW);
+  parser.load_with_mmap();
+
+  size_t count = 0;
+  size_t peak = 0;
+  parser.parse_mbo([&](const databento::MboMsg&) {
+    if (++count % 2000 == 0) {
+      peak = std::max(peak, parser.resident_bytes());
+    }
+  });
+
+  EXPECT_EQ(count, 200000u);
+  EXPECT_GT(peak, 0u);
+  EXPECT_LT(peak, parser.size() / 4) << "peak resident " << peak;
+  EXPECT_LT(parser.resident_bytes(), parser.size() / 4);
+  EXPECT_LT(resident_pages(test_file.path()) * sysconf(_SC_PAGESIZE), parser.size() / 4);
+}
+
+TEST(MmapWindowTest, RangeScanResidentStaysBounded) {
+  TestDbnFile test_file(200000);
+  if (!drop_page_cache(test_file.path())) {
+    GTEST_SKIP() << "Page cache could not be dropped for the test file";
+  }
+
+  databento::DbnParser parser(test_file.path());
+  parser.set_mmap_window(256 * 1024);
+  parser.load_with_mmap();
+
+  size_t count = 0;
+  size_t peak = 0;
+  parser.parse_mbo_range(0, UINT64_MAX, [&](const databento::MboMsg&) {
+    if (++count % 2000 == 0) {
+      peak = std::max(peak, parser.resident_bytes());
+    }
+  });
+
+  EXPECT_EQ(count, 200000u);
+  EXPECT_LT(peak, parser.size() / 4) << "peak resident " << peak;
+  EXPECT_LT(resident_pages(test_file.path()) * sysconf(_SC_PAGESIZE), parser.size() / 4);
+}
+
+TEST(MmapWindowTest, StatsReportWindow) {
+  TestDbnFile test_file(50000);
+
+  uint64_t count = 0;
+  auto stats = databento::parse_file_mbo(test_file.path(),
+      [&count](const databento::MboMsg&) { ++count; }, false, databento::HugePages::Off,
+      64 * 1024);
+
+  EXPECT_EQ(count, 50000u);
+  EXPECT_EQ(stats.mmap_window_bytes, 64u * 1024);
+  EXPECT_LE(stats.resident_bytes, stats.total_bytes + 200);
+
+  auto loaded = databento::parse_file_mbo(test_file.path(), [](const databento::MboMsg&) {});
+  EXPECT_EQ(loaded.mmap_window_bytes, 0u);
+  EXPECT_EQ(loaded.resident_bytes, 0u);
+}
+
+// ============================================================================
+// zstd Tests
+// ============================================================================
+
+TEST(ZstdTest, DetectsFrames) {
+  TestDbnFile test_file(10);
+  TestZstdFile zst_file(test_file.path(), 1);
+
+  EXPECT_TRUE(databento::is_zstd_file(zst_file.path()));
+  EXPECT_FALSE(databento::is_zstd_file(test_file.path()));
+  EXPECT_FALSE(databento::is_zstd_file("/nonexistent/file.dbn.zst"));
+}
+
+TEST(ZstdTest, LoadDecompressesMultiFrame) {
+  if (!databento::zstd_supported()) {
+    GTEST_SKIP() << "built without zstd support";
+  }
+  TestDbnFile test_file(20000);
+  TestZstdFile zst_file(test_file.path(), 7);
+
+  databento::DbnParser expected(test_file.path());
+  expected.load_into_memory();
+
+  for (size_t threads : {1, 4}) {
+    databento::DbnParser parser(zst_file.path());
+    parser.load_zstd(threads);
+
+    EXPECT_EQ(parser.io_backend(), databento::IoBackend::Zstd);
+    ASSERT_EQ(parser.size(), expected.size());
+    EXPECT_EQ(parser.num_records(), 20000);
+    EXPECT_EQ(std::memcmp(parser.data(), expected.data(), parser.size()), 0);
+  }
+
+  // Plain loaders detect the compressed file too
+  databento::DbnParser mapped(zst_file.path());
+  mapped.load_with_mmap();
+  EXPECT_EQ(mapped.io_backend(), databento::IoBackend::Zstd);
+  EXPECT_EQ(mapped.num_records(), 20000);
+}
+
+TEST(ZstdTest, StreamDecodesAcrossBlocks) {
+  if (!databento::zstd_supported()) {
+    GTEST_SKIP() << "built without zstd support";
+  }
+  TestDbnFile test_file(20000);
+  TestZstdFile zst_file(test_file.path(), 1);
+
+  // 64KB budget -> 16KB decoded blocks, so records straddle block edges
+  databento::DbnStream stream(zst_file.path(), 64 * 1024);
+
+  uint64_t next_order_id = 10000;
+  stream.parse_mbo([&](const databento::MboMsg& msg) {
+    EXPECT_EQ(msg.order_id, next_order_id++);
+  });
+
+  EXPECT_EQ(stream.io_backend(), databento::IoBackend::Zstd);
+  EXPECT_EQ(next_order_id, 30000);
+}
+
+TEST(ZstdTest, FrameParallelUsesAllWorkers) {
+  if (!databento::zstd_supported()) {
+    GTEST_SKIP() << "built without zstd support";
+  }
+  TestDbnFile test_file(20000);
+  TestZstdFile zst_file(test_file.path(), 16);
+
+  std::ifstream in(test_file.path(), std::ios::binary);
+  const std::vector<uint8_t> expected((std::istreambuf_iterator<char>(in)),
+                                      std::istreambuf_iterator<char>());
+
+  // The default queue depth (4) no longer caps the workers
+  databento::ZstdDecoder decoder(zst_file.path(), 8);
+  EXPECT_EQ(decoder.num_threads(), 8u);
+
+  std::vector<uint8_t> decoded;
+  databento::ZstdDecoder::Block block;
+  size_t blocks = 0;
+  while (decoder.next(block)) {
+    decoded.insert(decoded.end(), block.data(), block.data() + block.size);
+    ++blocks;
+  }
+  EXPECT_EQ(blocks, 16u);
+  EXPECT_EQ(decoded, expected);
+}
+
+TEST(ZstdTest, StreamBudgetBelowFrameSize) {
+  if (!databento::zstd_supported()) {
+    GTEST_SKIP() << "built without zstd support";
+  }
+  TestDbnFile test_file(20000);
+  TestZstdFile zst_file(test_file.path(), 3); // ~320KB frames
+
+  // What DbnStream uses for a 64KB budget: every block stays at 16KB
+  databento::ZstdDecoder decoder(zst_file.path(), 1, 16 * 1024, 2, 48);
+  databento::ZstdDecoder::Block block;
+  while (decoder.next(block)) {
+    EXPECT_LE(block.size, 16u * 1024);
+    EXPECT_LE(block.storage.size(), 16u * 1024 + 48);
+  }
+
+  databento::DbnStream stream(zst_file.path(), 64 * 1024);
+  uint64_t next_order_id = 10000;
+  stream.parse_mbo([&](const databento::MboMsg& msg) {
+    EXPECT_EQ(msg.order_id, next_order_id++);
+  });
+  EXPECT_EQ(next_order_id, 30000);
+}
+
+TEST(ZstdTest, CorruptContentSizeIsBounded) {
+  if (!databento::zstd_supported()) {
+    GTEST_SKIP() << "built without zstd support";
+  }
+  // First frame claims ~2^60 bytes: far past anything allocatable, so only
+  // a bounded preallocation gets as far as the decode error
+  TestDbnFile test_file(2000);
+  TestZstdFile zst_file(test_file.path(), 2, uint64_t{1} << 60);
+
+  databento::DbnParser parser(zst_file.path());
+  EXPECT_THROW(parser.load_zstd(2), std::runtime_error);
+}
+
+TEST(ZstdTest, StatsReportNoMmapWindow) {
+  if (!databento::zstd_supported()) {
+    GTEST_SKIP() << "built without zstd support";
+  }
+  TestDbnFile test_file(2000);
+  TestZstdFile zst_file(test_file.path(), 2);
+
+  // load_with_mmap() decodes a .dbn.zst into memory: no window was used
+  uint64_t count = 0;
+  auto stats = databento::parse_file_mbo(zst_file.path(),
+      [&count](const databento::MboMsg&) { ++count; }, false, databento::HugePages::Off,
+      64 * 1024);
+
+  EXPECT_EQ(count, 2000u);
+  EXPECT_EQ(stats.mmap_window_bytes, 0u);
+  EXPECT_EQ(stats.resident_bytes, 0u);
+}
+
+TEST(ZstdTest, UnsupportedBuildThrows) {
+  if (databento::zstd_supported()) {
+    GTEST_SKIP() << "built with zstd support";
+  }
+  TestDbnFile test_file(10);
+  TestZstdFile zst_file(test_file.path(), 1);
+
+  databento::DbnParser parser(zst_file.path());
+  EXPECT_THROW(parser.load_into_memory(), std::runtime_error);
+}
+
 // ============================================================================
 // Binary Reader Tests
 // ============================================================================
@@ -224,6 +1540,70 @@ TEST(BatchProcessorTest, ProcessBatches) {
   EXPECT_EQ(batch_count, 2); // 10 records / 5 per batch = 2 batches
 }
 
+TEST(BatchProcessorTest, SpanBatchesAreZeroCopy) {
+  TestDbnFile test_file(10);
+
+  databento::DbnParser parser(test_file.path());
+  databento::BatchProcessor batch_proc(4);
+
+  std::vector<size_t> batch_sizes;
+  uint64_t next_order_id = 10000;
+  batch_proc.process_batch_spans<databento::MboMsg>(parser,
+      [&](std::span<const databento::MboMsg> batch) {
+        // Views point straight into the mapped file
+        const auto* expected = parser.data() + parser.metadata_offset() +
+                               (next_order_id - 10000) * parser.record_size();
+        EXPECT_EQ(reinterpret_cast<const uint8_t*>(batch.data()), expected);
+
+        batch_sizes.push_back(batch.size());
+        for (const auto& msg : batch) {
+          EXPECT_EQ(msg.order_id, next_order_id++);
+        }
+      });
+
+  EXPECT_EQ(parser.io_backend(), databento::IoBackend::Mmap);
+  EXPECT_EQ(batch_sizes, (std::vector<size_t>{4, 4, 2}));
+}
+
+TEST(BatchProcessorTest, SpanBatchesOverStream) {
+  TestDbnFile test_file(1000);
+
+  databento::DbnStream stream(test_file.path(), 4096);
+  databento::BatchProcessor batch_proc(64);
+
+  uint64_t next_order_id = 10000;
+  batch_proc.process_batch_spans<databento::MboMsg>(stream,
+      [&](std::span<const databento::MboMsg> batch) {
+        EXPECT_LE(batch.size(), 64);
+        for (const auto& msg : batch) {
+          EXPECT_EQ(msg.order_id, next_order_id++);
+        }
+      });
+
+  EXPECT_EQ(next_order_id, 11000);
+}
+
+TEST(BatchProcessorTest, ColumnarBatches) {
+  TestDbnFile test_file(1000);
+
+  databento::DbnParser parser(test_file.path());
+  databento::BatchProcessor batch_proc(300);
+
+  uint64_t next = 0;
+  batch_proc.process_columns(parser, databento::COL_PRICE | databento::COL_SIZE,
+      [&](const databento::MboColumns& batch) {
+        EXPECT_EQ(batch.price.size(), batch.count);
+        EXPECT_EQ(batch.size.size(), batch.count);
+        EXPECT_TRUE(batch.ts_event.empty());
+        for (size_t i = 0; i < batch.count; ++i, ++next) {
+          EXPECT_EQ(batch.size[i], 100 + next * 10);
+          EXPECT_EQ(batch.price[i], 5000'000'000'000LL + static_cast<int64_t>(next) * 1'000'000'000LL);
+        }
+      });
+
+  EXPECT_EQ(next, 1000);
+}
+
 TEST(BatchProcessorTest, SetBatchSize) {
   databento::BatchProcessor batch_proc(1024);
   EXPECT_EQ(batch_proc.batch_size(), 1024);
@@ -253,6 +1633,41 @@ TEST(HighLevelAPITest, ParseFileMbo) {
   EXPECT_GT(stats.elapsed_seconds, 0);
 }
 
+TEST(HighLevelAPITest, ParseFileTradeInlined) {
+  TestDbnFile test_file;
+
+  int64_t max_price = 0;
+  auto stats = databento::parse_file_trade(test_file.path(),
+      [&max_price](const databento::TradeMsg& msg) {
+        max_price = std::max(max_price, msg.price);
+      });
+
+  EXPECT_EQ(stats.total_records, 10);
+  EXPECT_EQ(max_price, 5009'000'000'000LL);
+}
+
+TEST(HighLevelAPITest, StatsSplitLoadAndParse) {
+  TestDbnFile test_file;
+
+  auto stats = databento::parse_file_mbo(test_file.path(),
+      [](const databento::MboMsg&) {}, true);
+
+  EXPECT_EQ(stats.total_bytes, 10 * sizeof(databento::MboMsg));
+  EXPECT_GT(stats.load_seconds, 0);
+  EXPECT_GE(stats.parse_seconds, 0);
+  EXPECT_DOUBLE_EQ(stats.elapsed_seconds, stats.load_seconds + stats.parse_seconds);
+
+  // Counters are sampled only where the kernel exposes a PMU
+  EXPECT_EQ(stats.parse_counters.valid(), databento::PerfCounters::supported());
+  if (databento::PerfCounters::supported()) {
+    EXPECT_GT(*stats.load_counters.cycles, 0u);
+    EXPECT_GT(stats.parse_counters.ipc(), 0);
+  }
+
+  auto plain = databento::parse_file_mbo(test_file.path(), [](const databento::MboMsg&) {});
+  EXPECT_FALSE(plain.parse_counters.valid());
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -0,0 +1,193 @@
+"""Smoke tests for the databento_cpp Python bindings.
+
+Run after building the extension (pip install -e . or -DBUILD_PYTHON=ON,
+where ctest runs this file with the module on PYTHONPATH):
+
+    python tests/test_python.py
+"""
+
+import gc
+import os
+import struct
+import tempfile
+import threading
+import unittest
+
+import numpy as np
+
+import databento_cpp
+
+try:
+    import pyarrow
+except ImportError:
+    pyarrow = None
+
+# ============================================================================
+# Test Helpers
+# ============================================================================
+
+NUM_RECORDS = 1000
+METADATA_BYTES = 200
+
+# Packed MboMsg: ts_event, instrument_id, action, side, flags, depth, price,
+# size, channel_id, order_id, sequence, ts_in_delta, 3 reserved bytes
+MBO_STRUCT = struct.Struct("<QIccBBqIIQIB3x")
+assert MBO_STRUCT.size == 48
+
+
+def expected_price(i):
+    return (i - 500) * 1000
+
+
+def expected_action(i):
+    return b"ACMT"[i % 4:i % 4 + 1]
+
+
+def write_mbo_file(path):
+    with open(path, "wb") as f:
+        f.write(bytes(METADATA_BYTES))
+        for i in range(NUM_RECORDS):
+            f.write(MBO_STRUCT.pack(
+                1_700_000_000_000_000_000 + i, i % 7, expected_action(i),
+                b"AB"[i % 2:i % 2 + 1], i % 256, 1, expected_price(i), i + 1,
+                0, i * 3, i, 5))
+
+
+class BindingsTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        fd, cls.path = tempfile.mkstemp(prefix="test_databento_py_", suffix=".dbn")
+        os.close(fd)
+        write_mbo_file(cls.path)
+
+    @classmethod
+    def tearDownClass(cls):
+        os.remove(cls.path)
+
+    # ========================================================================
+    # to_numpy
+    # ========================================================================
+
+    def test_to_numpy_fields(self):
+        parser = databento_cpp.DbnParser(self.path)
+        records = parser.to_numpy()
+        self.assertEqual(len(records), NUM_RECORDS)
+        self.assertEqual(records.dtype.itemsize, parser.record_size())
+        np.testing.assert_array_equal(records["price"],
+                                      [expected_price(i) for i in range(NUM_RECORDS)])
+        np.testing.assert_array_equal(records["size"], np.arange(1, NUM_RECORDS + 1))
+        np.testing.assert_array_equal(records["instrument_id"], np.arange(NUM_RECORDS) % 7)
+        self.assertEqual(records["action"][3], b"T")
+        self.assertEqual(records["side"][1], b"B")
+        self.assertEqual(records["order_id"][10], 30)
+
+    def test_to_numpy_is_read_only(self):
+        records = databento_cpp.DbnParser(self.path).to_numpy()
+        self.assertFalse(records.flags.writeable)
+        with self.assertRaises(ValueError):
+            records["size"][0] = 7
+
+    def test_reload_refused_while_view_alive(self):
+        parser = databento_cpp.DbnParser(self.path)
+        records = parser.to_numpy()
+        prices = records["price"]  # Keeps records (and so the mapping) alive
+        del records
+        with self.assertRaises(BufferError):
+            parser.load_into_memory()
+        with self.assertRaises(BufferError):
+            parser.load_with_mmap()
+        self.assertEqual(prices[0], expected_price(0))
+
+        del prices
+        gc.collect()
+        parser.load_into_memory()
+        self.assertEqual(parser.to_numpy()["price"][-1], expected_price(NUM_RECORDS - 1))
+
+    # ========================================================================
+    # iter_batches
+    # ========================================================================
+
+    def test_iter_batches_columns(self):
+        parser = databento_cpp.DbnParser(self.path)
+        sizes = []
+        prices = []
+        actions = []
+        for batch in parser.iter_batches(batch_size=300, columns=["price", "action"]):
+            self.assertEqual(set(batch), {"price", "action"})
+            sizes.append(len(batch["price"]))
+            prices.append(batch["price"].copy())  # Buffers are reused
+            actions.append(batch["action"].copy())
+        self.assertEqual(sizes, [300, 300, 300, 100])
+        np.testing.assert_array_equal(np.concatenate(prices),
+                                      [expected_price(i) for i in range(NUM_RECORDS)])
+        self.assertEqual(np.concatenate(actions)[:4].tolist(), [b"A", b"C", b"M", b"T"])
+
+    def test_reload_refused_while_iterating(self):
+        parser = databento_cpp.DbnParser(self.path)
+        batches = parser.iter_batches(batch_size=300)
+        first = next(batches)
+        with self.assertRaises(BufferError):
+            parser.load_into_memory()
+        del batches  # first's arrays keep the iterator alive
+        with self.assertRaises(BufferError):
+            parser.load_with_mmap()
+        self.assertEqual(first["price"][0], expected_price(0))
+
+        del first
+        gc.collect()
+        parser.load_into_memory()
+
+    def test_iter_batches_shared_across_threads(self):
+        parser = databento_cpp.DbnParser(self.path)
+        batches = parser.iter_batches(batch_size=10)
+        sizes = []
+
+        def drain():
+            while True:
+                try:
+                    batch = next(batches)
+                except StopIteration:
+                    return
+                except ValueError:
+                    continue  # Another thread is mid-step
+                sizes.append(len(batch["price"]))
+
+        threads = [threading.Thread(target=drain) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        # No range is handed out twice
+        self.assertEqual(sum(sizes), NUM_RECORDS)
+
+    def test_iter_batches_unknown_column(self):
+        parser = databento_cpp.DbnParser(self.path)
+        with self.assertRaises(ValueError):
+            parser.iter_batches(columns=["price", "no_such_column"])
+
+    # ========================================================================
+    # Arrow
+    # ========================================================================
+
+    @unittest.skipIf(pyarrow is None, "pyarrow not installed")
+    def test_arrow_round_trip(self):
+        parser = databento_cpp.DbnParser(self.path)
+        batch = pyarrow.record_batch(parser.arrow_batch(start=10, count=20,
+                                                        columns=["price", "size"]))
+        self.assertEqual(batch.num_rows, 20)
+        self.assertEqual(batch.schema.names, ["price", "size"])
+        self.assertEqual(batch.column("price").to_pylist(),
+                         [expected_price(i) for i in range(10, 30)])
+        self.assertEqual(batch.column("size").to_pylist(), list(range(11, 31)))
+
+    @unittest.skipIf(pyarrow is None, "pyarrow not installed")
+    def test_arrow_batch_survives_reload(self):
+        parser = databento_cpp.DbnParser(self.path)
+        exported = parser.arrow_batch(start=990, columns=["size"])
+        parser.load_into_memory()  # Only blocked while an export is decoding
+        batch = pyarrow.record_batch(exported)
+        self.assertEqual(batch.column("size").to_pylist(), list(range(991, 1001)))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <databento/book.hpp>
+#include <databento/parser.hpp>
+#include <databento/synthetic.hpp>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dbn_test_file.hpp"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+static databento::SyntheticConfig small_config(size_t records) {
+  databento::SyntheticConfig config;
+  config.seed = 7;
+  config.num_records = records;
+  config.num_instruments = 6;
+  return config;
+}
+
+static std::vector<databento::MboMsg> generate_all(const databento::SyntheticConfig& config) {
+  constexpr size_t CHUNK = databento::SyntheticConfig::CHUNK_RECORDS;
+  std::vector<databento::MboMsg> records(config.num_records);
+  for (size_t start = 0; start < records.size(); start += CHUNK) {
+    const size_t n = std::min(CHUNK, records.size() - start);
+    databento::generate_mbo_chunk(config, start / CHUNK, {records.data() + start, n});
+  }
+  return records;
+}
+
+// ============================================================================
+// Generator Tests
+// ============================================================================
+
+TEST(SyntheticTest, TimestampsAndSequencesIncrease) {
+  const auto records = generate_all(small_config(300000));
+  for (size_t i = 1; i < records.size(); ++i) {
+    ASSERT_LT(records[i - 1].ts_event, records[i].ts_event) << "record " << i;
+    ASSERT_EQ(records[i].sequence, static_cast<uint32_t>(i));
+  }
+}
+
+TEST(SyntheticTest, ActionAndInstrumentMix) {
+  const auto config = small_config(300000);
+  const auto records = generate_all(config);
+  std::map<char, size_t> actions;
+  std::map<uint32_t, size_t> instruments;
+  size_t book_trades = 0;
+  for (const auto& msg : records) {
+    ++actions[msg.action];
+    book_trades += msg.action == 'T' && msg.side != 'N';
+    ++instruments[msg.instrument_id];
+  }
+  for (char action : {'A', 'C', 'M', 'T', 'F'}) {
+    EXPECT_GT(actions[action], records.size() / 100) << action;
+  }
+  EXPECT_EQ(book_trades, actions['F']); // Every on-book trade has its fill
+  EXPECT_EQ(instruments.size(), config.num_instruments);
+  // Skewed mix: the first instrument is the busiest
+  EXPECT_GT(instruments[config.first_instrument_id],
+            2 * instruments[config.first_instrument_id + config.num_instruments - 1]);
+}
+
+TEST(SyntheticTest, OrderLifecyclesAreConsistent) {
+  // Spans two chunks so the chunk boundary is exercised
+  const auto records = generate_all(small_config(databento::SyntheticConfig::CHUNK_RECORDS + 5000));
+
+  std::unordered_map<uint64_t, uint32_t> live; // order_id -> size
+  databento::BookBuilder books;
+  size_t crossed = 0;
+  for (const auto& msg : records) {
+    switch (msg.action) {
+      case 'A':
+        ASSERT_TRUE(live.emplace(msg.order_id, msg.size).second) << "duplicate order id";
+        break;
+      case 'C': {
+        auto it = live.find(msg.order_id);
+        ASSERT_NE(it, live.end()) << "cancel of unknown order";
+        ASSERT_LE(msg.size, it->second);
+        it->second -= msg.size;
+        if (it->second == 0) {
+          live.erase(it);
+        }
+        break;
+      }
+      case 'M':
+      case 'F':
+        ASSERT_TRUE(live.count(msg.order_id)) << msg.action << " of unknown order";
+        if (msg.action == 'M') {
+          live[msg.order_id] = msg.size;
+        }
+        break;
+    }
+    books.apply(msg);
+    const auto bbo = books.book(msg.instrument_id).bbo();
+    if (bbo.bid.size > 0 && bbo.ask.size > 0 && bbo.bid.price >= bbo.ask.price) {
+      ++crossed;
+    }
+  }
+  EXPECT_TRUE(live.empty()); // Every chunk closes its orders
+  EXPECT_EQ(crossed, 0u);
+}
+
+TEST(SyntheticTest, FileIsDeterministicAcrossThreadCounts) {
+  const std::string path_a = test_file_path("_a.dbn");
+  const std::string path_b = test_file_path("_b.dbn");
+  const auto config = small_config(2 * databento::SyntheticConfig::CHUNK_RECORDS + 123);
+  databento::write_synthetic_dbn(path_a, config, 1);
+  databento::write_synthetic_dbn(path_b, config, 3);
+
+  databento::DbnParser a(path_a);
+  databento::DbnParser b(path_b);
+  a.load_with_mmap();
+  b.load_with_mmap();
+  ASSERT_EQ(a.num_records(), config.num_records);
+  ASSERT_EQ(a.size(), b.size());
+  EXPECT_EQ(std::memcmp(a.data(), b.data(), a.size()), 0);
+
+  const auto expected = generate_all(config);
+  EXPECT_EQ(std::memcmp(a.get_batch(0, 0), expected.data(),
+                        expected.size() * sizeof(databento::MboMsg)), 0);
+
+  std::remove(path_a.c_str());
+  std::remove(path_b.c_str());
+}
+
+TEST(SyntheticTest, RejectsBadConfig) {
+  auto config = small_config(10);
+  config.num_instruments = 0;
+  std::vector<databento::MboMsg> out(10);
+  EXPECT_THROW(databento::generate_mbo_chunk(config, 0, out), std::invalid_argument);
+
+  config = small_config(10);
+  std::vector<databento::MboMsg> wrong(9);
+  EXPECT_THROW(databento::generate_mbo_chunk(config, 0, wrong), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}